@@ -0,0 +1,232 @@
+#include "branchscan.h"
+#include "disass.h"
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#if !defined(NEC850_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// A halfword h may start a control-flow row when (h & care) == want, which is
+// the row's mask/static_mask test restricted to its first halfword. Rows that
+// share a primary opcode are merged into one looser probe, so every hit is
+// confirmed with a full decode.
+#define MAX_PROBES 32
+#define OPCODE_BITS 0x07e0
+#define BLOCK_HALFWORDS 16
+
+typedef struct {
+  uint16_t care;
+  uint16_t want;
+} probe_t;
+
+static probe_t probes[MAX_PROBES];
+static size_t probe_count = 0;
+
+// Kernels test 16 halfwords and set bit 2k (and possibly 2k + 1) for a hit on
+// halfword k, which is the layout of a byte movemask.
+typedef uint32_t (*match_fn)(const uint8_t *block);
+static match_fn match_block = NULL;
+
+static int is_branch(uint8_t op_type) {
+    switch (op_type) {
+    case OP_TYPE_JMP:
+    case OP_TYPE_CJMP:
+    case OP_TYPE_CALL:
+    case OP_TYPE_RJMP:
+    case OP_TYPE_RCALL:
+    case OP_TYPE_LOOP:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void add_probe(uint16_t care, uint16_t want) {
+    for (size_t i = 0; i < probe_count; i++) {
+        probe_t *probe = &probes[i];
+        if ((probe->care & OPCODE_BITS) != (care & OPCODE_BITS) || (probe->want & OPCODE_BITS) != (want & OPCODE_BITS))
+            continue;
+        // keep only the bits both probes agree on
+        probe->care &= care & ~(probe->want ^ want);
+        probe->want &= probe->care;
+        return;
+    }
+    if (probe_count == MAX_PROBES) {
+        // out of room, fall back to a probe that accepts everything
+        probes[0].care = probes[0].want = 0;
+        return;
+    }
+    probes[probe_count].care = care;
+    probes[probe_count].want = want;
+    probe_count++;
+}
+
+#ifndef SCAN_X86
+static uint32_t match_scalar(const uint8_t *block) {
+    uint32_t hits = 0;
+    for (int k = 0; k < BLOCK_HALFWORDS; k++) {
+        uint16_t h = (uint16_t)(block[2 * k + 1] << 8 | block[2 * k]);
+        for (size_t i = 0; i < probe_count; i++) {
+            if ((h & probes[i].care) == probes[i].want) {
+                hits |= 1u << (2 * k);
+                break;
+            }
+        }
+    }
+    return hits;
+}
+#else
+static uint32_t match_sse2(const uint8_t *block) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)block);
+    __m128i hi = _mm_loadu_si128((const __m128i *)(block + 16));
+    __m128i hit_lo = _mm_setzero_si128();
+    __m128i hit_hi = _mm_setzero_si128();
+    for (size_t i = 0; i < probe_count; i++) {
+        __m128i care = _mm_set1_epi16((short)probes[i].care);
+        __m128i want = _mm_set1_epi16((short)probes[i].want);
+        hit_lo = _mm_or_si128(hit_lo, _mm_cmpeq_epi16(_mm_and_si128(lo, care), want));
+        hit_hi = _mm_or_si128(hit_hi, _mm_cmpeq_epi16(_mm_and_si128(hi, care), want));
+    }
+    return (uint32_t)_mm_movemask_epi8(hit_lo) | (uint32_t)_mm_movemask_epi8(hit_hi) << 16;
+}
+
+TARGET_AVX2 static uint32_t match_avx2(const uint8_t *block) {
+    __m256i h = _mm256_loadu_si256((const __m256i *)block);
+    __m256i hit = _mm256_setzero_si256();
+    for (size_t i = 0; i < probe_count; i++) {
+        __m256i care = _mm256_set1_epi16((short)probes[i].care);
+        __m256i want = _mm256_set1_epi16((short)probes[i].want);
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi16(_mm256_and_si256(h, care), want));
+    }
+    return (uint32_t)_mm256_movemask_epi8(hit);
+}
+
+static int cpu_has_avx2(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+    __cpuid(info, 1);
+    // the OS must save the AVX state (OSXSAVE and AVX, then XCR0 bits 1-2)
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+        return 0;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+static inline int lowest_bit(uint32_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+static void build_probes(void) {
+    disassemble_init();
+    for (uint32_t i = 0; i < instruction_count; i++) {
+        const disass_insn_t *row = &instruction_list[i];
+        if (!is_branch(row->op_type))
+            continue;
+        uint16_t shift = row->size * 8 - 16;
+        uint16_t mask = (uint16_t)(row->mask >> shift);
+        uint16_t want = (uint16_t)(row->static_mask >> shift);
+        add_probe((uint16_t)(~mask | want), want);
+    }
+#ifdef SCAN_X86
+    match_block = cpu_has_avx2() ? match_avx2 : match_sse2;
+#else
+    match_block = match_scalar;
+#endif
+}
+
+// The probes are built exactly once, and the once primitive publishes them to
+// every thread that returns from scan_branches_init().
+#ifdef _WIN32
+static INIT_ONCE init_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK build_probes_once(PINIT_ONCE once, PVOID param, PVOID *context) {
+    (void)once;
+    (void)param;
+    (void)context;
+    build_probes();
+    return TRUE;
+}
+
+void scan_branches_init(void) {
+    InitOnceExecuteOnce(&init_once, build_probes_once, NULL, NULL);
+}
+#else
+static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+
+void scan_branches_init(void) {
+    pthread_once(&init_once, build_probes);
+}
+#endif
+
+static int confirm(const uint8_t *buffer, size_t len, size_t offset, uint32_t address, branch_site_cb cb, void *ctx) {
+    insn_t insn;
+    branch_site_t site;
+    if (disassemble_into(buffer + offset, len - offset, &insn) != DISASS_OK || !is_branch(insn.op_type))
+        return 0;
+    site.address = address + (uint32_t)offset;
+    site.size = insn.size;
+    site.insn_id = insn.insn_id;
+    site.op_type = insn.op_type;
+    if (insn.op_type == OP_TYPE_LOOP)
+        site.target = site.address - (uint32_t)insn.fields[1].value;
+    else if (insn.fields[0].type == TYPE_JMP || insn.fields[0].type == TYPE_MEM)
+        site.target = site.address + (uint32_t)insn.fields[0].value;
+    else
+        site.target = 0;
+    cb(ctx, &site);
+    return 1;
+}
+
+size_t scan_branches(const uint8_t *buffer, size_t len, uint32_t address, branch_site_cb cb, void *ctx) {
+    size_t found = 0;
+    size_t offset = 0;
+    uint8_t tail[BLOCK_HALFWORDS * 2];
+    scan_branches_init();
+    while (offset + 2 <= len) {
+        const uint8_t *block = buffer + offset;
+        size_t block_len = len - offset;
+        if (block_len < sizeof(tail)) {
+            // pad the last block, halfwords past the end never start a site
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, block_len);
+            block = tail;
+        } else {
+            block_len = sizeof(tail);
+        }
+        uint32_t hits = match_block(block);
+        while (hits) {
+            int k = lowest_bit(hits) / 2;
+            hits &= ~(3u << (2 * k));
+            if ((size_t)(2 * k + 2) > block_len)
+                break;
+            found += confirm(buffer, len, offset + 2 * k, address, cb, ctx);
+        }
+        offset += sizeof(tail);
+    }
+    return found;
+}
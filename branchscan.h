@@ -0,0 +1,35 @@
+#ifndef BRANCHSCAN_H
+#define BRANCHSCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+// A plausible control-flow instruction found by scan_branches().
+typedef struct {
+  uint32_t address;
+  uint32_t target;   // absolute target, 0 for register-indirect branches
+  uint8_t size;
+  uint8_t insn_id;   // enum insn_id
+  uint8_t op_type;   // enum insn_type
+} branch_site_t;
+
+typedef void (*branch_site_cb)(void *ctx, const branch_site_t *site);
+
+// Builds the scan filters and picks the SIMD kernel for this CPU, once. Called
+// by scan_branches() and safe to call from several threads.
+void scan_branches_init(void);
+
+// Tests every halfword of buffer against the control-flow rows of the decoder
+// table and reports each jr/jarl/jmp/Bcond/loop that decodes there, in address
+// order. address is the address of buffer[0]. Returns the number of sites.
+size_t scan_branches(const uint8_t *buffer, size_t len, uint32_t address, branch_site_cb cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BRANCHSCAN_H
@@ -0,0 +1,24 @@
+#ifndef DECODE_TREE_H
+#define DECODE_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+// The first three halfwords as one word, first halfword most significant:
+// (h0 << 32) | (h1 << 16) | h2, with missing halfwords left 0. A row of size s
+// tests the top s * 8 bits.
+#define DECODE_WORD_BITS 48
+
+// Generated at build time from instruction_list by tools/gen_decoder.c. Returns
+// the index of the first row matching word with at most avail bytes, or -1.
+int decode_tree(uint64_t word, size_t avail);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DECODE_TREE_H
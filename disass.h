@@ -1,3 +1,7 @@
+#ifndef DISASS_H
+#define DISASS_H
+
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -331,25 +335,138 @@ enum sign {
   SIGNED
 };
 
+#define INSN_MAX_SIZE 6
+
+enum disass_status {
+  DISASS_OK = 0,
+  DISASS_INVALID = 1,   // no instruction matches the bytes
+  DISASS_TRUNCATED = 2  // fewer than 2 bytes available
+};
+
+// Decoded instructions are packed so that one fits in 48 bytes.
 typedef struct {
-  int64_t value;
-  uint64_t size;
-  enum sign sign;
-  enum op_type type;
+  int32_t value;  // unsigned 32-bit immediates too, cast to uint32_t before widening
+  uint8_t size;   // in bits
+  uint8_t sign;   // enum sign
+  uint8_t type;   // enum op_type
 } insn_op_t;
 
+#define INSN_MAX_OPERANDS 5
+
 typedef struct {
-  const char* name;
-  enum insn_id insn_id;
-  insn_op_t fields[10];
-  uint16_t n;
-  uint16_t size;
-  enum insn_type op_type;
-  enum op_condition cond;
+  insn_op_t fields[INSN_MAX_OPERANDS];
+  uint16_t row;     // index into the instruction table
+  uint8_t insn_id;  // enum insn_id
+  uint8_t n;
+  uint8_t size;
+  uint8_t op_type;  // enum insn_type
+  uint8_t cond;     // enum op_condition
 } insn_t;
 
+#ifdef __cplusplus
+static_assert(sizeof(insn_t) == 48, "insn_t must stay packed in 48 bytes");
+#else
+_Static_assert(sizeof(insn_t) == 48, "insn_t must stay packed in 48 bytes");
+#endif
+
+typedef struct {
+  uint64_t mask;
+  uint16_t shr;
+  uint16_t shl;
+  uint16_t add;
+  uint16_t size; // in bits
+  uint16_t sign; // 0 unsigned
+  uint16_t index;
+  enum op_type type;
+} disass_op_t;
+
+typedef struct {
+  const char* name; //instructio name
+  enum insn_id insn_id;  // Instruction ID
+  uint16_t size; // instruction size
+  uint64_t mask; // instruction mask
+  uint64_t static_mask;
+  uint16_t n; // Number of arguments
+  enum insn_type op_type; // Type of oepration
+  enum op_condition cond; // Conditionals
+  disass_op_t fields[5]; // Operands
+} disass_insn_t;
+
+// The decoder table, rows are matched first to last.
+extern const disass_insn_t instruction_list[];
+extern const uint32_t instruction_count;
+
+// Structure-of-arrays output of disassemble_batch(). The caller owns the arrays:
+// each holds capacity entries, values holds capacity * INSN_MAX_OPERANDS.
+// Entry i has its operands at values[i * INSN_MAX_OPERANDS].
+#define DISASS_BATCH_INVALID 0xffff
+
+typedef struct {
+  size_t capacity;
+  size_t count;
+  uint32_t *address;
+  uint8_t *size;
+  uint16_t *insn_id;  // DISASS_BATCH_INVALID for bytes that do not decode
+  uint8_t *op_type;   // enum insn_type
+  int32_t *values;
+} insn_batch_t;
+
+// Prepares the decoder. The generated decoder needs no setup today, but callers
+// should still call it once before decoding from several threads.
+void disassemble_init(void);
+// Decodes into a caller-owned insn_t, reading at most avail bytes.
+enum disass_status disassemble_into(const uint8_t *in_buffer, size_t avail, insn_t *out);
+// Heap-allocating variant, the caller frees the result.
 insn_t *disassemble(const uint8_t *in_buffer);
+const char *insn_name(const insn_t *insn);
+// Finds the same row as disassemble_into() without extracting operands. Returns
+// the instruction size and its enum insn_type, or 0 if nothing matches.
+uint8_t disassemble_length(const uint8_t *in_buffer, size_t avail, uint8_t *op_type);
+// Linear sweep of in_buffer into out until it is full or the bytes run out.
+// Undecodable halfwords become 2-byte DISASS_BATCH_INVALID entries. Returns the
+// number of bytes consumed, address is the address of in_buffer[0].
+size_t disassemble_batch(const uint8_t *in_buffer, size_t len, uint32_t address, insn_batch_t *out);
 
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+
+#include <vector>
+
+// insn_batch_t backed by vectors, for sweeping a segment from C++.
+class InsnBatch : public insn_batch_t
+{
+	std::vector<uint32_t> addresses;
+	std::vector<uint8_t> sizes;
+	std::vector<uint16_t> insn_ids;
+	std::vector<uint8_t> op_types;
+	std::vector<int32_t> operand_values;
+
+public:
+	explicit InsnBatch(size_t entries) : insn_batch_t(),
+		addresses(entries), sizes(entries), insn_ids(entries), op_types(entries),
+		operand_values(entries * INSN_MAX_OPERANDS)
+	{
+		capacity = entries;
+		address = addresses.data();
+		size = sizes.data();
+		insn_id = insn_ids.data();
+		op_type = op_types.data();
+		values = operand_values.data();
+	}
+
+	InsnBatch(const InsnBatch &) = delete;
+	InsnBatch &operator=(const InsnBatch &) = delete;
+
+	size_t Decode(const uint8_t *data, size_t len, uint32_t start)
+	{
+		return disassemble_batch(data, len, start, this);
+	}
+
+	const int32_t *Operands(size_t i) const
+	{
+		return &values[i * INSN_MAX_OPERANDS];
+	}
+};
+#endif
+
+#endif // DISASS_H
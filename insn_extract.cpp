@@ -0,0 +1,205 @@
+/* Per-row operand extractors, generated at compile time from a constexpr copy
+   of the instruction table.
+
+   The rows in insn_table.inc describe every encoding format (reg-reg, imm5,
+   disp16, the 48-bit forms, bins, the FPU rows) with the same five field
+   descriptors. Here each row instantiates Extract<Row>. Every descriptor is a
+   compile-time constant, so the field loop, the mask == 0 checks, sign
+   extension and the bins/ldsr fixups fold away and each row compiles to its
+   own fixed shift/mask sequence. The results match the generic loop in
+   disass.c exactly: the fields are combined in table order, then the operands
+   are post-processed in order. The mnemonics are kept here too, padded for the
+   listing lines of insn_text.c. */
+#include "disass.h"
+#include "decode_tree.h"
+#include "insn_extract.h"
+#include <utility>
+
+namespace
+{
+	constexpr disass_insn_t table[] =
+	{
+#include "insn_table.inc"
+	};
+	constexpr size_t tableSize = sizeof(table) / sizeof(table[0]);
+
+	/* What operand Op of row Row looks like after its fields are combined. */
+	template <size_t Row, size_t Op>
+	struct Operand
+	{
+		static constexpr bool Present()
+		{
+			for (const disass_op_t &field : table[Row].fields)
+				if (field.mask != 0 && field.index == Op)
+					return true;
+			return false;
+		}
+
+		static constexpr uint8_t Size()
+		{
+			uint8_t size = 0;
+			for (const disass_op_t &field : table[Row].fields)
+				if (field.mask != 0 && field.index == Op)
+					size += (uint8_t)field.size;
+			return size;
+		}
+
+		static constexpr uint8_t Sign()
+		{
+			uint8_t sign = 0;
+			for (const disass_op_t &field : table[Row].fields)
+				if (field.mask != 0 && field.index == Op)
+					sign = (uint8_t)field.sign;
+			return sign;
+		}
+
+		/* Type before the bins fixups turn it into TYPE_IMM. */
+		static constexpr uint8_t Type()
+		{
+			uint8_t type = TYPE_NONE;
+			for (const disass_op_t &field : table[Row].fields)
+				if (field.mask != 0 && field.index == Op)
+					type = field.type == TYPE_EP ? TYPE_REG_MEM : (uint8_t)field.type;
+			return type;
+		}
+
+		static constexpr bool SignExtend()
+		{
+			return (Type() == TYPE_IMM || Type() == TYPE_JMP || Type() == TYPE_MEM) && Sign() == SIGNED;
+		}
+	};
+
+	template <size_t Row, size_t Op, size_t Field>
+	inline void Accumulate(uint64_t data, int32_t &value)
+	{
+		constexpr const disass_op_t &field = table[Row].fields[Field];
+		if constexpr (field.mask != 0 && field.index == Op)
+		{
+			if constexpr (field.type == TYPE_EP)
+				value = 30;
+			else
+				value |= (int32_t)(((int64_t)(data & field.mask) >> field.shr << field.shl) + field.add);
+		}
+	}
+
+	template <size_t Row, size_t Op, size_t... Fields>
+	inline void ExtractValue(uint64_t data, int32_t *values, std::index_sequence<Fields...>)
+	{
+		int32_t value = 0;
+		if constexpr (Operand<Row, Op>::Present())
+			(Accumulate<Row, Op, Fields>(data, value), ...);
+		values[Op] = value;
+	}
+
+	/* The post-pass of the generic decoder for one operand. */
+	template <size_t Row, size_t Op>
+	inline void FixValue(int32_t *values)
+	{
+		using Info = Operand<Row, Op>;
+		if constexpr (Info::SignExtend())
+		{
+			constexpr int64_t m = (int64_t)1 << (Info::Size() - 1);
+			values[Op] = (int32_t)((values[Op] ^ m) - m);
+		}
+		if constexpr (Info::Type() == TYPE_BINS2 || Info::Type() == TYPE_BINS3)
+			values[Op] = values[Op] - (values[1] - 1);
+		else if constexpr (Info::Type() == TYPE_BINS)
+			values[Op] = values[Op] - (values[1] - 0x10) + 1;
+		else if constexpr (Info::Type() == TYPE_SYSREG)
+			values[Op] += (values[2] * 40) + 100;
+	}
+
+	template <size_t Row, size_t... Ops>
+	inline void ExtractValues(uint64_t word, int32_t *values, std::index_sequence<Ops...>)
+	{
+		const uint64_t data = word >> (DECODE_WORD_BITS - table[Row].size * 8);
+		(ExtractValue<Row, Ops>(data, values, std::make_index_sequence<INSN_MAX_OPERANDS>()), ...);
+		(FixValue<Row, Ops>(values), ...);
+	}
+
+	template <size_t Row, size_t Op>
+	inline void SetOperand(insn_t *out, int32_t value)
+	{
+		using Info = Operand<Row, Op>;
+		if constexpr (Info::Present())
+		{
+			constexpr uint8_t type = Info::Type();
+			out->fields[Op].value = value;
+			out->fields[Op].size = Info::Size();
+			out->fields[Op].sign = Info::Sign();
+			/* the bins fixups leave an immediate */
+			out->fields[Op].type = type == TYPE_BINS || type == TYPE_BINS2 || type == TYPE_BINS3 ? TYPE_IMM : type;
+		}
+	}
+
+	template <size_t Row, size_t... Ops>
+	inline void ExtractRow(uint64_t word, insn_t *out, std::index_sequence<Ops...> ops)
+	{
+		constexpr const disass_insn_t &row = table[Row];
+		int32_t values[INSN_MAX_OPERANDS];
+
+		ExtractValues<Row>(word, values, ops);
+		*out = insn_t();
+		out->row = (uint16_t)Row;
+		out->size = (uint8_t)row.size;
+		out->op_type = (uint8_t)row.op_type;
+		out->cond = (uint8_t)row.cond;
+		out->insn_id = (uint8_t)row.insn_id;
+		out->n = (uint8_t)row.n;
+		(SetOperand<Row, Ops>(out, values[Ops]), ...);
+	}
+
+	template <size_t Row>
+	void Extract(uint64_t word, insn_t *out)
+	{
+		ExtractRow<Row>(word, out, std::make_index_sequence<INSN_MAX_OPERANDS>());
+	}
+
+	template <size_t Row>
+	insn_row_info_t ExtractOperandValues(uint64_t word, int32_t *values)
+	{
+		ExtractValues<Row>(word, values, std::make_index_sequence<INSN_MAX_OPERANDS>());
+		return { (uint8_t)table[Row].size, (uint8_t)table[Row].op_type, (uint16_t)table[Row].insn_id };
+	}
+
+	constexpr insn_mnemonic_t Mnemonic(size_t row)
+	{
+		insn_mnemonic_t mnemonic = {};
+		size_t i = 0;
+		for (; table[row].name[i]; i++)
+			mnemonic.text[i] = table[row].name[i];
+		mnemonic.len = (uint8_t)i;
+		for (; i < INSN_MNEMONIC_SIZE; i++)
+			mnemonic.text[i] = ' ';
+		return mnemonic;
+	}
+
+	constexpr bool MnemonicsFit()
+	{
+		for (const disass_insn_t &row : table)
+		{
+			size_t len = 0;
+			while (row.name[len])
+				len++;
+			if (len >= INSN_MNEMONIC_SIZE)
+				return false;
+		}
+		return true;
+	}
+	static_assert(MnemonicsFit(), "a mnemonic does not fit insn_mnemonic_t");
+
+	template <typename Rows>
+	struct Extractors;
+
+	template <size_t... Rows>
+	struct Extractors<std::index_sequence<Rows...>>
+	{
+		static constexpr insn_extract_fn list[] = { &Extract<Rows>... };
+		static constexpr insn_values_fn values[] = { &ExtractOperandValues<Rows>... };
+		static constexpr insn_mnemonic_t mnemonics[] = { Mnemonic(Rows)... };
+	};
+}
+
+extern "C" const insn_extract_fn *const insn_extractors = Extractors<std::make_index_sequence<tableSize>>::list;
+extern "C" const insn_values_fn *const insn_value_extractors = Extractors<std::make_index_sequence<tableSize>>::values;
+extern "C" const insn_mnemonic_t *const insn_mnemonics = Extractors<std::make_index_sequence<tableSize>>::mnemonics;
@@ -0,0 +1,47 @@
+#ifndef INSN_EXTRACT_H
+#define INSN_EXTRACT_H
+
+#include <stdint.h>
+#include "disass.h"
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+// Fills *out from the decode_tree.h word of an instruction that matched the
+// row. Every row has its own extractor, generated at compile time by
+// insn_extract.cpp.
+typedef void (*insn_extract_fn)(uint64_t word, insn_t *out);
+
+// The instruction_list fields a sweep needs, as constants of the row.
+typedef struct {
+  uint8_t size;
+  uint8_t op_type;   // enum insn_type
+  uint16_t insn_id;  // enum insn_id
+} insn_row_info_t;
+
+// The operand values alone, values[i] being what the row's insn_extract_fn puts
+// in out->fields[i].value (0 for absent operands), and the row's size and ids.
+// Used by disassemble_batch().
+typedef insn_row_info_t (*insn_values_fn)(uint64_t word, int32_t *values);
+
+// One extractor per instruction_list row.
+extern const insn_extract_fn *const insn_extractors;
+extern const insn_values_fn *const insn_value_extractors;
+
+// A row's mnemonic padded with spaces to INSN_MNEMONIC_SIZE bytes, so listing
+// lines copy it and its padding in one go. len is the length of the name.
+#define INSN_MNEMONIC_SIZE 16
+typedef struct {
+  char text[INSN_MNEMONIC_SIZE];
+  uint8_t len;
+} insn_mnemonic_t;
+
+// One per instruction_list row.
+extern const insn_mnemonic_t *const insn_mnemonics;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INSN_EXTRACT_H
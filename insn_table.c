@@ -0,0 +1,10 @@
+#include "disass.h"
+
+const disass_insn_t instruction_list[] = {
+#include "insn_table.inc"
+};
+
+
+#define INSN_LIST_SIZE (sizeof (instruction_list) / sizeof (disass_insn_t))
+
+const uint32_t instruction_count = INSN_LIST_SIZE;
@@ -0,0 +1,383 @@
+#include "insn_text.h"
+#include "insn_extract.h"
+#include "nec850.h"
+#include <string.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+const char reg_name[][INSN_NAME_SIZE] = {
+    "r0",
+    "r1",
+    "r2",
+    "sp",
+    "gp",
+    "tp",
+    "r6",
+    "r7",
+    "r8",
+    "r9",
+    "r10",
+    "r11",
+    "r12",
+    "r13",
+    "r14",
+    "r15",
+    "r16",
+    "r17",
+    "r18",
+    "r19",
+    "r20",
+    "r21",
+    "r22",
+    "r23",
+    "r24",
+    "r25",
+    "r26",
+    "r27",
+    "r28",
+    "r29",
+    "ep",
+    "lp",
+    "pc"};
+
+const char reg_mem_name[][INSN_NAME_SIZE] = {
+    "[r0]",
+    "[r1]",
+    "[r2]",
+    "[sp]",
+    "[gp]",
+    "[tp]",
+    "[r6]",
+    "[r7]",
+    "[r8]",
+    "[r9]",
+    "[r10]",
+    "[r11]",
+    "[r12]",
+    "[r13]",
+    "[r14]",
+    "[r15]",
+    "[r16]",
+    "[r17]",
+    "[r18]",
+    "[r19]",
+    "[r20]",
+    "[r21]",
+    "[r22]",
+    "[r23]",
+    "[r24]",
+    "[r25]",
+    "[r26]",
+    "[r27]",
+    "[r28]",
+    "[r29]",
+    "[ep]",
+    "[lp]",
+    "[pc]"};
+
+const char cccc_name[][INSN_NAME_SIZE] = {
+    "v",
+    "c/l",
+    "z",
+    "nh",
+    "s/n",
+    "t",
+    "lt",
+    "le",
+    "nv",
+    "nc/nl",
+    "nz",
+    "h",
+    "ns/p",
+    "INVALID",
+    "ge",
+    "gt"};
+
+const char cond_name[][INSN_NAME_SIZE] = {
+    "f",
+    "un",
+    "eq",
+    "ueq",
+    "olt",
+    "ult",
+    "ole",
+    "ule",
+    "sf",
+    "ngle",
+    "seq",
+    "ngl",
+    "lt",
+    "nge",
+    "le",
+    "ngt"};
+
+// Indexed by sysreg id - NEC_SYSREG_EIPC, ids without a name are empty.
+static const char sysreg_names[NEC_SYSREG_MEI - NEC_SYSREG_EIPC + 1][INSN_NAME_SIZE] = {
+    [NEC_SYSREG_EIPC - NEC_SYSREG_EIPC] = "eipc",
+    [NEC_SYSREG_EIPSW - NEC_SYSREG_EIPC] = "eipsw",
+    [NEC_SYSREG_FEPC - NEC_SYSREG_EIPC] = "fepc",
+    [NEC_SYSREG_FEPSW - NEC_SYSREG_EIPC] = "fepsw",
+    [NEC_SYSREG_PSW - NEC_SYSREG_EIPC] = "psw",
+    [NEC_SYSREG_FPSR - NEC_SYSREG_EIPC] = "fpsr",
+    [NEC_SYSREG_FPEPC - NEC_SYSREG_EIPC] = "fpepc",
+    [NEC_SYSREG_FPST - NEC_SYSREG_EIPC] = "fpst",
+    [NEC_SYSREG_FPCC - NEC_SYSREG_EIPC] = "fpcc",
+    [NEC_SYSREG_FPCFG - NEC_SYSREG_EIPC] = "fpcfg",
+    [NEC_SYSREG_FPEC - NEC_SYSREG_EIPC] = "fpec",
+    [NEC_SYSREG_EIIC - NEC_SYSREG_EIPC] = "eiic",
+    [NEC_SYSREG_FEIC - NEC_SYSREG_EIPC] = "feic",
+    [NEC_SYSREG_CTPC - NEC_SYSREG_EIPC] = "ctpc",
+    [NEC_SYSREG_CTPSW - NEC_SYSREG_EIPC] = "ctpsw",
+    [NEC_SYSREG_CTBP - NEC_SYSREG_EIPC] = "ctbp",
+    [NEC_SYSREG_EIWR - NEC_SYSREG_EIPC] = "eiwr",
+    [NEC_SYSREG_FEWR - NEC_SYSREG_EIPC] = "fewr",
+    [NEC_SYSREG_BSEL - NEC_SYSREG_EIPC] = "bsel",
+    [NEC_SYSREG_MCFG0 - NEC_SYSREG_EIPC] = "mcfg0",
+    [NEC_SYSREG_RBASE - NEC_SYSREG_EIPC] = "rbase",
+    [NEC_SYSREG_EBASE - NEC_SYSREG_EIPC] = "ebase",
+    [NEC_SYSREG_INTBP - NEC_SYSREG_EIPC] = "intbp",
+    [NEC_SYSREG_MCTL - NEC_SYSREG_EIPC] = "mctl",
+    [NEC_SYSREG_PID - NEC_SYSREG_EIPC] = "pid",
+    [NEC_SYSREG_SCCFG - NEC_SYSREG_EIPC] = "sccfg",
+    [NEC_SYSREG_SCBP - NEC_SYSREG_EIPC] = "scbp",
+    [NEC_SYSREG_HTCFG0 - NEC_SYSREG_EIPC] = "htcfg0",
+    [NEC_SYSREG_MEA - NEC_SYSREG_EIPC] = "mea",
+    [NEC_SYSREG_ASID - NEC_SYSREG_EIPC] = "asid",
+    [NEC_SYSREG_MEI - NEC_SYSREG_EIPC] = "mei",
+};
+
+const char *sysreg_name(int sysreg_id) {
+    static const char invalid[INSN_NAME_SIZE] = "INVALID";
+    unsigned index = (unsigned)(sysreg_id - NEC_SYSREG_EIPC);
+    const char *name = index < sizeof(sysreg_names) / sizeof(sysreg_names[0]) ? sysreg_names[index] : invalid;
+    return name[0] ? name : invalid;
+}
+
+static void put_token(insn_token_t *token, uint8_t kind, const char *text) {
+    token->kind = kind;
+    strncpy(token->text, text, INSN_TOKEN_TEXT_SIZE - 1);
+    token->text[INSN_TOKEN_TEXT_SIZE - 1] = 0;
+    token->value = 0;
+}
+
+// Eight nibbles, one per byte, as ASCII hex digits.
+static inline uint64_t hex_ascii(uint64_t nibbles) {
+    uint64_t letters = ((nibbles + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+    return nibbles + 0x3030303030303030ull + letters * ('a' - '0' - 10);
+}
+
+// Writes the lowest `digits` hex digits of value, most significant first.
+// Always stores 8 bytes, the ones past the digits are scratch.
+static inline char *put_hex(char *p, uint32_t value, int digits) {
+    uint64_t x = value;
+    // nibble i of value into byte i
+    x = (x | x << 16) & 0x0000ffff0000ffffull;
+    x = (x | x << 8) & 0x00ff00ff00ff00ffull;
+    x = (x | x << 4) & 0x0f0f0f0f0f0f0f0full;
+    x = hex_ascii(x) << (8 * (8 - digits));
+    for (int i = 0; i < 8; i++)
+        p[i] = (char)(x >> (56 - 8 * i));
+    return p + digits;
+}
+
+// Number of hex digits without leading zeros, 1 for 0.
+static inline int hex_digits(uint32_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit;
+    _BitScanReverse(&bit, value | 1);
+    return (int)bit / 4 + 1;
+#else
+    return (31 - __builtin_clz(value | 1)) / 4 + 1;
+#endif
+}
+
+size_t insn_format_hex(char *out, uint32_t value, int is_signed) {
+    int negative = is_signed && (int32_t)value < 0;
+    char *p = out;
+    *p = '-';
+    p += negative;
+    value = negative ? 0u - value : value;
+    p[0] = '0';
+    p[1] = 'x';
+    p = put_hex(p + 2, value, hex_digits(value));
+    *p = 0;
+    return (size_t)(p - out);
+}
+
+// Copies a padded INSN_NAME_SIZE name as one word. Past the name it is all
+// NULs, so its length is the number of nonzero bytes.
+static inline char *put_name(char *p, const char *name) {
+    uint64_t word = 0, nonzero;
+    for (int i = 0; i < INSN_NAME_SIZE; i++)
+        word |= (uint64_t)(uint8_t)name[i] << (8 * i);
+    memcpy(p, name, INSN_NAME_SIZE);
+    nonzero = (((word & 0x7f7f7f7f7f7f7f7full) + 0x7f7f7f7f7f7f7f7full) | word) & 0x8080808080808080ull;
+    return p + (((nonzero >> 7) * 0x0101010101010101ull) >> 56);
+}
+
+// Writes the text of one operand at p and returns the end, p itself for an
+// operand that is not shown. *kind and *value receive what insn_operand_tokens
+// puts in the token, so the tokens and the listing lines share one formatter.
+static char *put_operand(char *p, const insn_op_t *op, uint64_t addr, uint8_t *kind, int64_t *value) {
+    *kind = INSN_TOKEN_REGISTER;
+    *value = 0;
+    switch (op->type) {
+    case TYPE_REG:
+        return put_name(p, reg_name[op->value]);
+    case TYPE_REG_MEM:
+        return put_name(p, reg_mem_name[op->value]);
+    case TYPE_MEM:
+        if (op->value == 0)
+            return p;
+        // fall through
+    case TYPE_IMM:
+        *kind = INSN_TOKEN_INTEGER;
+        *value = op->sign ? (int64_t)op->value : (int64_t)(uint32_t)op->value;
+        return p + insn_format_hex(p, (uint32_t)op->value, op->sign);
+    case TYPE_JMP:
+        *kind = INSN_TOKEN_INTEGER;
+        *value = (int64_t)(addr + op->value);
+        return p + insn_format_hex(p, (uint32_t)op->value + (uint32_t)addr, 0);
+    case TYPE_LOOP:
+        *kind = INSN_TOKEN_INTEGER;
+        *value = (int64_t)(addr - op->value);
+        return p + insn_format_hex(p, (uint32_t)addr - (uint32_t)op->value, 0);
+    case TYPE_CCCC:
+        return put_name(p, cccc_name[op->value]);
+    case TYPE_COND:
+        return put_name(p, cond_name[op->value]);
+    case TYPE_SYSREG:
+        return put_name(p, sysreg_name(op->value));
+    default:
+        return p;
+    }
+}
+
+size_t insn_operand_tokens(const insn_t *insn, uint64_t addr, insn_token_t out[INSN_MAX_OPERAND_TOKENS]) {
+    size_t count = 0;
+
+    for (int op_index = 0; op_index < insn->n; op_index++) {
+        const insn_op_t *op = &insn->fields[op_index];
+        insn_token_t *token = &out[count];
+        char *end;
+        // a register in brackets follows its displacement without a separator
+        if (op_index > 0 && op->type != TYPE_REG_MEM) {
+            put_token(token++, INSN_TOKEN_SEPARATOR, ", ");
+            count++;
+        }
+        end = put_operand(token->text, op, addr, &token->kind, &token->value);
+        if (end != token->text) {
+            *end = 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t insn_tokens(const insn_t *insn, uint64_t addr, insn_token_t out[INSN_MAX_TOKENS]) {
+    const char *name = insn_name(insn);
+    size_t name_len = strlen(name);
+    size_t count = 0;
+
+    put_token(&out[count++], INSN_TOKEN_MNEMONIC, name);
+    if (insn->n == 0)
+        return count;
+    out[count].kind = INSN_TOKEN_TEXT;
+    out[count].value = 0;
+    memset(out[count].text, ' ', INSN_TOKEN_TEXT_SIZE);
+    out[count].text[name_len < INSN_MNEMONIC_COLUMNS ? INSN_MNEMONIC_COLUMNS - name_len : 0] = 0;
+    count++;
+    return count + insn_operand_tokens(insn, addr, out + count);
+}
+
+_Static_assert(INSN_MNEMONIC_COLUMNS <= INSN_MNEMONIC_SIZE, "the mnemonic padding must come from insn_mnemonics");
+
+// The text insn_tokens splits up, written at p without a terminator. p needs
+// INSN_TEXT_SIZE bytes. Returns the end.
+static char *put_insn_text(char *p, const insn_t *insn, uint64_t addr) {
+    const insn_mnemonic_t *mnemonic = &insn_mnemonics[insn->row];
+    uint8_t kind;
+    int64_t value;
+
+    memcpy(p, mnemonic->text, INSN_MNEMONIC_SIZE);
+    if (insn->n == 0)
+        return p + mnemonic->len;
+    p += mnemonic->len < INSN_MNEMONIC_COLUMNS ? INSN_MNEMONIC_COLUMNS : mnemonic->len;
+    for (int op_index = 0; op_index < insn->n; op_index++) {
+        const insn_op_t *op = &insn->fields[op_index];
+        p[0] = ',';
+        p[1] = ' ';
+        p += 2 * (op_index > 0 && op->type != TYPE_REG_MEM);
+        p = put_operand(p, op, addr, &kind, &value);
+    }
+    return p;
+}
+
+size_t insn_text(const insn_t *insn, uint64_t addr, char *buf, size_t size) {
+    char text[INSN_TEXT_SIZE];
+    size_t len = (size_t)(put_insn_text(text, insn, addr) - text);
+    if (size == 0)
+        return 0;
+    if (len >= size)
+        len = size - 1;
+    memcpy(buf, text, len);
+    buf[len] = 0;
+    return len;
+}
+
+size_t insn_line(const uint8_t *data, size_t avail, uint32_t address, char *out, uint8_t *size) {
+    insn_t insn;
+    enum disass_status status = disassemble_into(data, avail, &insn);
+    uint8_t tail[INSN_MAX_SIZE] = {0};
+    const uint8_t *bytes = data;
+    uint64_t word = 0, high, low;
+    char *p = out;
+
+    *size = status == DISASS_OK ? insn.size : avail < 2 ? 1 : 2;
+    p = put_hex(p, address, 8);
+    *p++ = ':';
+    *p++ = '\t';
+    // every byte column is "xx ", all of them are written from one word and the
+    // ones past the instruction blanked
+    if (avail < INSN_MAX_SIZE) {
+        memcpy(tail, data, avail);
+        bytes = tail;
+    }
+    for (int i = 0; i < INSN_MAX_SIZE; i++)
+        word |= (uint64_t)bytes[i] << (8 * i);
+    high = hex_ascii((word >> 4) & 0x0f0f0f0f0f0f0f0full);
+    low = hex_ascii(word & 0x0f0f0f0f0f0f0f0full);
+    for (int i = 0; i < INSN_MAX_SIZE; i++) {
+        p[3 * i] = (char)(high >> (8 * i));
+        p[3 * i + 1] = (char)(low >> (8 * i));
+        p[3 * i + 2] = ' ';
+    }
+    memcpy(p + 3 * *size, "                ", 16);
+    p += 3 * INSN_MAX_SIZE;
+    *p++ = '\t';
+    if (status == DISASS_OK) {
+        p = put_insn_text(p, &insn, address);
+    } else if (*size == 1) {
+        memcpy(p, ".byte 0x", 8);
+        p = put_hex(p + 8, data[0], 2);
+    } else {
+        memcpy(p, ".hword 0x", 9);
+        p = put_hex(p + 9, (uint32_t)(data[1] << 8 | data[0]), 4);
+    }
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+size_t insn_render(const uint8_t *in_buffer, size_t len, uint32_t address, insn_listing_t *out) {
+    size_t offset = 0;
+    uint8_t size;
+    out->len = 0;
+    out->lines = 0;
+    while (offset < len && out->capacity - out->len >= INSN_LINE_SIZE) {
+        out->len += insn_line(in_buffer + offset, len - offset, address + (uint32_t)offset, out->text + out->len, &size);
+        out->lines++;
+        offset += size;
+    }
+    return offset;
+}
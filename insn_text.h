@@ -0,0 +1,114 @@
+#ifndef INSN_TEXT_H
+#define INSN_TEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "disass.h"
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+// The name tables are NUL-padded to INSN_NAME_SIZE bytes, so the listing
+// renderer copies a name as one word.
+#define INSN_NAME_SIZE 8
+extern const char reg_name[][INSN_NAME_SIZE];
+// reg_name in brackets, for register operands that address memory
+extern const char reg_mem_name[][INSN_NAME_SIZE];
+extern const char cccc_name[][INSN_NAME_SIZE];
+extern const char cond_name[][INSN_NAME_SIZE];
+
+// Name of a system register id (regID + 40 * selID + 100), "INVALID" if unknown.
+// A table lookup, the names are static and padded like the tables above.
+const char *sysreg_name(int sysreg_id);
+
+enum insn_token_kind {
+  INSN_TOKEN_MNEMONIC,
+  INSN_TOKEN_TEXT,
+  INSN_TOKEN_SEPARATOR,
+  INSN_TOKEN_REGISTER,
+  INSN_TOKEN_INTEGER
+};
+
+// up to INSN_MAX_OPERANDS operands with separators
+#define INSN_MAX_OPERAND_TOKENS (2 * INSN_MAX_OPERANDS)
+// the mnemonic and its padding, then the operand tokens
+#define INSN_MAX_TOKENS (2 + INSN_MAX_OPERAND_TOKENS)
+#define INSN_TOKEN_TEXT_SIZE 16
+#define INSN_TEXT_SIZE (INSN_MAX_TOKENS * INSN_TOKEN_TEXT_SIZE)
+
+typedef struct {
+  uint8_t kind;   // enum insn_token_kind
+  char text[INSN_TOKEN_TEXT_SIZE];
+  int64_t value;  // INSN_TOKEN_INTEGER only
+} insn_token_t;
+
+// Writes value as "0x" and lowercase hex digits without leading zeros, or as
+// "-0x..." when is_signed and value is negative as an int32_t, the way printf's
+// "0x%x" would. out needs INSN_HEX_SIZE bytes and is NUL-terminated. Returns the
+// length.
+#define INSN_HEX_SIZE 12
+size_t insn_format_hex(char *out, uint32_t value, int is_signed);
+
+// The mnemonic is padded to this many columns when the instruction has operands.
+#define INSN_MNEMONIC_COLUMNS 14
+
+// Splits a decoded instruction at addr into display tokens, the way the plugin
+// shows it. Returns the number of tokens written to out.
+size_t insn_tokens(const insn_t *insn, uint64_t addr, insn_token_t out[INSN_MAX_TOKENS]);
+// Only the operand tokens that insn_tokens puts after the mnemonic and its
+// padding, for callers that keep those per row. out needs room for
+// INSN_MAX_OPERAND_TOKENS tokens.
+size_t insn_operand_tokens(const insn_t *insn, uint64_t addr, insn_token_t out[INSN_MAX_OPERAND_TOKENS]);
+// Concatenated token text, returns its length (truncated to size - 1).
+size_t insn_text(const insn_t *insn, uint64_t addr, char *buf, size_t size);
+// Renders one objdump-style listing line ("address: bytes<tab>text\n") for the
+// instruction at data into out, which must hold INSN_LINE_SIZE bytes. The line
+// is not NUL-terminated. *size receives the bytes consumed, 2 for a halfword that
+// does not decode (printed as .hword) and 1 for a final odd byte (printed as
+// .byte). Returns the line length.
+#define INSN_LINE_SIZE (16 + 3 * INSN_MAX_SIZE + INSN_TEXT_SIZE)
+size_t insn_line(const uint8_t *data, size_t avail, uint32_t address, char *out, uint8_t *size);
+
+// A caller-owned text buffer for rendering listings in bulk.
+typedef struct {
+  char *text;
+  size_t capacity;
+  size_t len;    // bytes written by the last insn_render
+  size_t lines;  // lines written by the last insn_render
+} insn_listing_t;
+
+// Renders the linear sweep of in_buffer as insn_line lines into out->text, until
+// the data ends or there is no room for another INSN_LINE_SIZE line. Nothing is
+// allocated. Returns the number of bytes consumed, address is the address of
+// in_buffer[0]; call again with the rest after draining the text.
+size_t insn_render(const uint8_t *in_buffer, size_t len, uint32_t address, insn_listing_t *out);
+
+#ifdef __cplusplus
+}
+
+#include <vector>
+
+// insn_listing_t backed by a vector, reused across calls.
+class InsnListing : public insn_listing_t
+{
+	std::vector<char> storage;
+
+public:
+	InsnListing(size_t bytes = 1 << 20) : insn_listing_t(), storage(bytes < INSN_LINE_SIZE ? INSN_LINE_SIZE : bytes)
+	{
+		text = storage.data();
+		capacity = storage.size();
+	}
+
+	InsnListing(const InsnListing &) = delete;
+	InsnListing &operator=(const InsnListing &) = delete;
+
+	size_t Render(const uint8_t *data, size_t size, uint32_t address)
+	{
+		return insn_render(data, size, address, this);
+	}
+};
+#endif
+
+#endif // INSN_TEXT_H
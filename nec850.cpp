@@ -2,10 +2,16 @@
 #include "nec850.h"
 #include "binaryninjaapi.h"
 #include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include "disass.h"
+#include "branchscan.h"
+#include "insn_text.h"
 #include "binaryninjaapi.h"
 #include "binaryninjacore.h"
 #include "lowlevelilinstruction.h"
@@ -13,76 +19,210 @@
 using namespace BinaryNinja;
 using namespace std;
 
-static const char *reg_name[] = {
-	"r0",
-	"r1",
-	"r2",
-	"sp",
-	"gp",
-	"tp",
-	"r6",
-	"r7",
-	"r8",
-	"r9",
-	"r10",
-	"r11",
-	"r12",
-	"r13",
-	"r14",
-	"r15",
-	"r16",
-	"r17",
-	"r18",
-	"r19",
-	"r20",
-	"r21",
-	"r22",
-	"r23",
-	"r24",
-	"r25",
-	"r26",
-	"r27",
-	"r28",
-	"r29",
-	"ep",
-	"lp",
-	"pc"};
-
-static const char *cccc_name[] = {
-	"v",
-	"c/l",
-	"z",
-	"nh",
-	"s/n",
-	"t",
-	"lt",
-	"le",
-	"nv",
-	"nc/nl",
-	"nz",
-	"h",
-	"ns/p",
-	"INVALID",
-	"ge",
-	"gt"};
-
-static const char *cond_name[] = {
-	"f",
-	"un",
-	"eq",
-	"ueq",
-	"olt",
-	"ult",
-	"ole",
-	"ule",
-	"sf",
-	"ngle",
-	"seq",
-	"ngl",
-	"lt",
-	"nge",
-	"le",
-	"ngt"};
+/* Most instructions lift to one register write, compare, load, store or
+   operand-less intrinsic. Those are described by a LiftRule and built by
+   NEC850::LiftFromRule; everything else keeps its own case in
+   GetInstructionLowLevelIL. */
+enum LiftForm
+{
+	LIFT_SET,       /* dest = op(a, b), or dest = a when op is LLIL_NOP */
+	LIFT_COMPARE,   /* op(a, b), only for the flags it writes */
+	LIFT_LOAD,      /* dest = op(load(a + b)), op is LLIL_SX, LLIL_ZX or LLIL_NOP */
+	LIFT_STORE,     /* store(a + b, c) */
+	LIFT_INTRINSIC  /* intrinsic without outputs or inputs */
+};
+
+enum LiftSourceKind
+{
+	LIFT_NONE,
+	LIFT_REG,
+	LIFT_IMM
+};
+
+/* A register or immediate operand read with size bytes, then extended to four
+   bytes when ext is LLIL_SX or LLIL_ZX. */
+struct LiftSource
+{
+	uint8_t kind;
+	uint8_t field;
+	uint8_t size;
+	BNLowLevelILOperation ext;
+};
+
+struct LiftRule
+{
+	uint32_t insnId;
+	uint8_t form;
+	BNLowLevelILOperation op;
+	uint8_t size;           /* operation width, the access width for loads and stores */
+	uint8_t dest;           /* operand holding the destination register */
+	LiftSource a, b, c;
+	uint32_t flags;         /* flag write type of the operation */
+	uint32_t intrinsic;
+};
+
+static constexpr LiftSource LiftReg(uint8_t field, uint8_t size = 4, BNLowLevelILOperation ext = LLIL_NOP)
+{
+	return LiftSource{LIFT_REG, field, size, ext};
+}
+
+static constexpr LiftSource LiftImm(uint8_t field, uint8_t size, BNLowLevelILOperation ext = LLIL_NOP)
+{
+	return LiftSource{LIFT_IMM, field, size, ext};
+}
+
+static constexpr LiftRule LiftSet(uint32_t insnId, BNLowLevelILOperation op, uint8_t dest, LiftSource a,
+	LiftSource b = LiftSource{}, uint32_t flags = 0)
+{
+	return LiftRule{insnId, LIFT_SET, op, 4, dest, a, b, LiftSource{}, flags, 0};
+}
+
+static constexpr LiftRule LiftCompare(uint32_t insnId, BNLowLevelILOperation op, LiftSource a, LiftSource b,
+	uint32_t flags)
+{
+	return LiftRule{insnId, LIFT_COMPARE, op, 4, 0, a, b, LiftSource{}, flags, 0};
+}
+
+static constexpr LiftRule LiftLoad(uint32_t insnId, uint8_t size, BNLowLevelILOperation ext, uint8_t dest,
+	LiftSource base, LiftSource disp = LiftSource{})
+{
+	return LiftRule{insnId, LIFT_LOAD, ext, size, dest, base, disp, LiftSource{}, 0, 0};
+}
+
+static constexpr LiftRule LiftStore(uint32_t insnId, uint8_t size, LiftSource base, LiftSource disp, LiftSource value)
+{
+	return LiftRule{insnId, LIFT_STORE, LLIL_NOP, size, 0, base, disp, value, 0, 0};
+}
+
+static constexpr LiftRule LiftIntrinsic(uint32_t insnId, uint32_t intrinsic)
+{
+	return LiftRule{insnId, LIFT_INTRINSIC, LLIL_NOP, 0, 0, LiftSource{}, LiftSource{}, LiftSource{}, 0, intrinsic};
+}
+
+static const LiftRule liftTable[] = {
+	/* integer arithmetic, logic and shifts */
+	LiftSet(N850_ADD, LLIL_ADD, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_ADD_IMM, LLIL_ADD, 1, LiftReg(1), LiftImm(0, 1, LLIL_SX), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_ADDI, LLIL_ADD, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_MOVEA, LLIL_ADD, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftSet(N850_SUB, LLIL_SUB, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_SUBR, LLIL_SUB, 1, LiftReg(0), LiftReg(1), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_SATADD, LLIL_ADD, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_ALL),
+	LiftSet(N850_SATADDI, LLIL_ADD, 1, LiftReg(1), LiftImm(0, 1, LLIL_SX), FLAG_WRITE_ALL),
+	LiftSet(N850_SATADDR, LLIL_ADD, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_ALL),
+	LiftSet(N850_SATSUB, LLIL_SUB, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_ALL),
+	LiftSet(N850_SATSUBI, LLIL_SUB, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX), FLAG_WRITE_ALL),
+	LiftSet(N850_SATSUBL, LLIL_SUB, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_ALL),
+	LiftSet(N850_SATSUBR, LLIL_SUB, 1, LiftReg(0), LiftReg(1), FLAG_WRITE_ALL),
+	LiftSet(N850_MULH, LLIL_MUL, 1, LiftReg(1, 2), LiftReg(0, 2)),
+	LiftSet(N850_MULHI, LLIL_MUL, 2, LiftReg(1, 2), LiftImm(0, 2)),
+	LiftSet(N850_DIVH, LLIL_DIVS, 1, LiftReg(1), LiftReg(0, 2, LLIL_SX), FLAG_WRITE_SZ),
+	LiftSet(N850_AND, LLIL_AND, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_ANDI, LLIL_AND, 2, LiftReg(1), LiftImm(0, 2, LLIL_ZX), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_OR, LLIL_OR, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_ORI, LLIL_OR, 2, LiftReg(1), LiftImm(0, 2, LLIL_ZX), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_XOR, LLIL_XOR, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_XORI, LLIL_XOR, 2, LiftReg(1), LiftImm(0, 2, LLIL_ZX), FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_NOT, LLIL_NOT, 1, LiftReg(0), LiftSource{}, FLAG_WRITE_SZ_OV0),
+	LiftSet(N850_SHL, LLIL_LSL, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHLI, LLIL_LSL, 1, LiftReg(1), LiftImm(0, 1, LLIL_ZX), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHLL, LLIL_LSL, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHR, LLIL_LSR, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHRI, LLIL_LSR, 1, LiftReg(1), LiftImm(0, 1, LLIL_ZX), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHRL, LLIL_LSR, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SHRR, LLIL_LSR, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SAR, LLIL_ASR, 1, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SARI, LLIL_ASR, 1, LiftReg(1), LiftImm(0, 1, LLIL_ZX), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_SARR, LLIL_ASR, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_CYSZ_OV0),
+	LiftSet(N850_ROTL, LLIL_ROL, 2, LiftReg(1), LiftReg(0), FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_ROTLI, LLIL_ROL, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX), FLAG_WRITE_CYOVSZ),
+	LiftCompare(N850_CMP, LLIL_SUB, LiftReg(1), LiftReg(0), FLAG_WRITE_CYOVSZ),
+	LiftCompare(N850_CMPI, LLIL_SUB, LiftReg(1), LiftImm(0, 1, LLIL_SX), FLAG_WRITE_CYOVSZ),
+	LiftCompare(N850_TST, LLIL_AND, LiftReg(1), LiftReg(0), FLAG_WRITE_SZ_OV0),
+
+	/* moves and extensions */
+	LiftSet(N850_MOV, LLIL_NOP, 1, LiftReg(0)),
+	LiftSet(N850_MOVI5, LLIL_NOP, 1, LiftImm(0, 1, LLIL_SX)),
+	LiftSet(N850_MOVI, LLIL_NOP, 1, LiftImm(0, 4)),
+	LiftSet(N850_LDSR, LLIL_NOP, 1, LiftReg(0)),
+	LiftSet(N850_STSR, LLIL_NOP, 1, LiftReg(0)),
+	LiftSet(N850_HSH, LLIL_NOP, 1, LiftReg(0), LiftSource{}, FLAG_WRITE_CYOVSZ),
+	LiftSet(N850_SXB, LLIL_SX, 0, LiftReg(0, 1)),
+	LiftSet(N850_SXH, LLIL_SX, 0, LiftReg(0, 2)),
+	LiftSet(N850_ZXB, LLIL_ZX, 0, LiftReg(0, 1)),
+	LiftSet(N850_ZXH, LLIL_ZX, 0, LiftReg(0, 2)),
+
+	/* loads: disp16, disp23 and the short ep-relative forms */
+	LiftLoad(N850_LDB, 1, LLIL_SX, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftLoad(N850_LDBU, 1, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftLoad(N850_LDH, 2, LLIL_SX, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftLoad(N850_LDHU, 2, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftLoad(N850_LDW, 4, LLIL_NOP, 2, LiftReg(1), LiftImm(0, 2, LLIL_SX)),
+	LiftLoad(N850_LDBL, 1, LLIL_SX, 2, LiftReg(1), LiftImm(0, 3, LLIL_SX)),
+	LiftLoad(N850_LDBUL, 1, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 3, LLIL_SX)),
+	LiftLoad(N850_LDHL, 2, LLIL_SX, 2, LiftReg(1), LiftImm(0, 3, LLIL_SX)),
+	LiftLoad(N850_LDHUL, 2, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 3, LLIL_SX)),
+	LiftLoad(N850_LDWL, 4, LLIL_NOP, 2, LiftReg(1), LiftImm(0, 3, LLIL_SX)),
+	LiftLoad(N850_SLDB, 1, LLIL_SX, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX)),
+	LiftLoad(N850_SLDBU, 1, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX)),
+	LiftLoad(N850_SLDH, 2, LLIL_SX, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX)),
+	LiftLoad(N850_SLDHU, 2, LLIL_ZX, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX)),
+	LiftLoad(N850_SLDW, 4, LLIL_NOP, 2, LiftReg(1), LiftImm(0, 1, LLIL_ZX)),
+	LiftLoad(N850_LDLW, 4, LLIL_NOP, 1, LiftReg(0)),
+
+	/* stores */
+	LiftStore(N850_STB, 1, LiftReg(2), LiftImm(1, 2, LLIL_SX), LiftReg(0)),
+	LiftStore(N850_STH, 2, LiftReg(2), LiftImm(1, 2, LLIL_SX), LiftReg(0)),
+	LiftStore(N850_STW, 4, LiftReg(2), LiftImm(1, 2, LLIL_SX), LiftReg(0)),
+	LiftStore(N850_STDL, 1, LiftReg(2), LiftImm(1, 3, LLIL_SX), LiftReg(0, 1)),
+	LiftStore(N850_STHL, 2, LiftReg(2), LiftImm(1, 3, LLIL_SX), LiftReg(0, 2)),
+	LiftStore(N850_STWL, 4, LiftReg(2), LiftImm(1, 3, LLIL_SX), LiftReg(0)),
+	LiftStore(N850_SSTB, 1, LiftReg(2), LiftImm(1, 1, LLIL_ZX), LiftReg(0)),
+	LiftStore(N850_SSTH, 2, LiftReg(2), LiftImm(1, 1, LLIL_ZX), LiftReg(0)),
+	LiftStore(N850_SSTW, 4, LiftReg(2), LiftImm(1, 1, LLIL_ZX), LiftReg(0)),
+	LiftStore(N850_STCW, 4, LiftReg(1), LiftSource{}, LiftReg(0)),
+
+	/* single precision FPU */
+	LiftSet(N850_ADDFS, LLIL_FADD, 2, LiftReg(1), LiftReg(0)),
+	LiftSet(N850_SUBFS, LLIL_FSUB, 2, LiftReg(1), LiftReg(0)),
+	LiftSet(N850_MULFS, LLIL_FMUL, 2, LiftReg(1), LiftReg(0)),
+	LiftSet(N850_DIVFS, LLIL_FDIV, 2, LiftReg(1), LiftReg(0)),
+	LiftSet(N850_ABSFS, LLIL_FABS, 1, LiftReg(0)),
+	LiftSet(N850_NEGFS, LLIL_FNEG, 1, LiftReg(0)),
+	LiftSet(N850_SQRTFS, LLIL_FSQRT, 1, LiftReg(0)),
+	LiftSet(N850_CVTFHS, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFLS, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFSH, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFSUW, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFSW, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFULS, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFUWS, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CVTFWS, LLIL_FLOAT_CONV, 1, LiftReg(0)),
+	LiftSet(N850_CEILFSUW, LLIL_CEIL, 1, LiftReg(0)),
+	LiftSet(N850_CEILFSW, LLIL_CEIL, 1, LiftReg(0)),
+	LiftSet(N850_FLOORFSUW, LLIL_FLOOR, 1, LiftReg(0)),
+	LiftSet(N850_FLOORFSW, LLIL_FLOOR, 1, LiftReg(0)),
+	LiftSet(N850_ROUNDFSUW, LLIL_ROUND_TO_INT, 1, LiftReg(0)),
+	LiftSet(N850_ROUNDFSW, LLIL_ROUND_TO_INT, 1, LiftReg(0)),
+	LiftSet(N850_TRNCFSUW, LLIL_FTRUNC, 1, LiftReg(0)),
+	LiftSet(N850_TRNCFSW, LLIL_FTRUNC, 1, LiftReg(0)),
+
+	/* system instructions */
+	LiftIntrinsic(N850_CLL, CLL_INTRINSIC),
+	LiftIntrinsic(N850_DI, SYNC_EXCEPTIONS),
+	LiftIntrinsic(N850_EI, EI_INTRINSIC),
+	LiftIntrinsic(N850_HALT, SYNC_EXCEPTIONS),
+	LiftIntrinsic(N850_SNOOZE, SNOOZE_INTRINSIC),
+	LiftIntrinsic(N850_SYNCE, SYNC_EXCEPTIONS),
+	LiftIntrinsic(N850_SYNCI, SYNC_INSN_FETCHER),
+	LiftIntrinsic(N850_SYNCM, SYNC_MEMORY_ACCESS),
+	LiftIntrinsic(N850_SYNCP, SYNC_PIPELINE),
+	LiftIntrinsic(N850_RIE, RIE_INTRINSIC),
+	LiftIntrinsic(N850_RIEI, RIE_INTRINSIC),
+};
+
+/* list12 of prepare and dispose, the bit that selects register r20 + i */
+static const uint8_t list12Bit[12] = {6, 5, 4, 3, 10, 9, 8, 7, 2, 1, 11, 0};
 
 class NEC850 : public Architecture
 {
@@ -100,85 +240,240 @@ private:
 		return result;
 	}
 
+	/* Binary Ninja asks for the info, IL and text of an address one after the
+	   other, so every thread keeps its latest decodes in a direct-mapped cache
+	   keyed on the address and the bytes that were available. */
+	static const size_t DECODE_CACHE_ENTRIES = 64;
+
+	/* largest switch table that ResolveSwitchTables reads */
+	static const uint32_t SWITCH_MAX_CASES = 1024;
+
+	struct DecodeCacheEntry
+	{
+		uint64_t addr;
+		uint8_t bytes[INSN_MAX_SIZE];
+		uint8_t avail;
+		insn_t insn;
+	};
+
+	struct DecodeCache;
+
+	/* the live caches and the counts that exited threads left behind, never
+	   destroyed because threads can exit after the static destructors ran */
+	struct DecodeCacheRegistry
+	{
+		std::mutex lock;
+		std::vector<DecodeCache *> caches;
+		uint64_t exitedHits = 0;
+		uint64_t exitedMisses = 0;
+	};
+
+	static DecodeCacheRegistry &CacheRegistry()
+	{
+		static DecodeCacheRegistry *registry = new DecodeCacheRegistry();
+		return *registry;
+	}
+
+	/* only the owning thread writes the counters, so counting needs no
+	   read-modify-write and GetDecodeCacheStats can read them at any time */
+	struct DecodeCache
+	{
+		DecodeCacheEntry entries[DECODE_CACHE_ENTRIES] = {};
+		std::atomic<uint64_t> hits{0};
+		std::atomic<uint64_t> misses{0};
+
+		DecodeCache()
+		{
+			DecodeCacheRegistry &registry = CacheRegistry();
+			std::lock_guard<std::mutex> guard(registry.lock);
+			registry.caches.push_back(this);
+		}
+
+		~DecodeCache()
+		{
+			DecodeCacheRegistry &registry = CacheRegistry();
+			std::lock_guard<std::mutex> guard(registry.lock);
+			registry.exitedHits += hits.load(std::memory_order_relaxed);
+			registry.exitedMisses += misses.load(std::memory_order_relaxed);
+			registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), this));
+		}
+
+		static void Count(std::atomic<uint64_t> &counter)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	};
+
+	/* mnemonic and padding tokens of every instruction_list row, so that
+	   rendering a line only formats its operands */
+	std::vector<std::vector<InstructionTextToken>> mnemonicTokens;
+
+	/* Binary Ninja queries the register, flag and intrinsic metadata for every
+	   function it analyses, so it is built once in the constructor and only
+	   copied out afterwards */
+	std::vector<uint32_t> allFlags;
+	std::vector<uint32_t> allFlagWriteTypes;
+	std::vector<uint32_t> flagsWrittenByType[FLAG_WRITE_CYSZ_OV0 + 1];
+	std::vector<uint32_t> allSemanticFlagClasses;
+	std::vector<uint32_t> allSemanticFlagGroups;
+	std::vector<uint32_t> flagsRequiredForGroup[FLAG_GROUP_GT + 1];
+	std::map<uint32_t, BNLowLevelILFlagCondition> flagConditionsForGroup[FLAG_GROUP_GT + 1];
+	std::vector<uint32_t> fullWidthRegisters;
+	std::vector<uint32_t> allRegisters;
+	std::vector<uint32_t> systemRegisters;
+	std::vector<uint32_t> allIntrinsics;
+	std::vector<NameAndType> intrinsicInputs[RIE_INTRINSIC + 1];
+	std::vector<Confidence<Ref<Type>>> intrinsicOutputs[RIE_INTRINSIC + 1];
+	BNRegisterInfo registerInfo[NEC_SYSREG_MEI + 1];
+
+	/* liftTable indexed by insn_id, NULL for the hand-written instructions */
+	const LiftRule *liftRules[N850_SHRR + 1];
+
+	const insn_t *Decode(const uint8_t *data, uint64_t addr, size_t len)
+	{
+		static thread_local DecodeCache cache;
+		if (len < 2)
+			return NULL;
+		size_t avail = len < INSN_MAX_SIZE ? len : INSN_MAX_SIZE;
+		DecodeCacheEntry &entry = cache.entries[(addr >> 1) % DECODE_CACHE_ENTRIES];
+
+		/* empty and failed slots have avail 0, which never matches */
+		if (entry.avail == avail && entry.addr == addr && memcmp(entry.bytes, data, avail) == 0)
+		{
+			DecodeCache::Count(cache.hits);
+			return &entry.insn;
+		}
+		DecodeCache::Count(cache.misses);
+		entry.avail = 0;
+		if (disassemble_into(data, len, &entry.insn) != DISASS_OK)
+			return NULL;
+		entry.addr = addr;
+		entry.avail = avail;
+		memcpy(entry.bytes, data, avail);
+		return &entry.insn;
+	}
+
 public:
 	/* initialization list */
 	NEC850(const char *name) : Architecture(name)
 	{
-	}
+		mnemonicTokens.resize(instruction_count);
+		for (uint32_t row = 0; row < instruction_count; row++)
+		{
+			const disass_insn_t &entry = instruction_list[row];
+			size_t nameLen = strlen(entry.name);
+			mnemonicTokens[row].emplace_back(InstructionToken, entry.name);
+			if (entry.n != 0)
+				mnemonicTokens[row].emplace_back(TextToken,
+					std::string(nameLen < INSN_MNEMONIC_COLUMNS ? INSN_MNEMONIC_COLUMNS - nameLen : 0, ' '));
+		}
 
-	/*************************************************************************/
+		allFlags = {FLAG_SAT, FLAG_CY, FLAG_OV, FLAG_S, FLAG_Z};
+		allFlagWriteTypes = {FLAG_WRITE_NONE, FLAG_WRITE_ALL, FLAG_WRITE_OVSZ, FLAG_WRITE_CYOVSZ, FLAG_WRITE_Z, FLAG_WRITE_SZ,
+			FLAG_WRITE_CYSZ, FLAG_WRITE_SZ_OV0, FLAG_WRITE_CYSZ_OV0};
+		flagsWrittenByType[FLAG_WRITE_CYSZ] = {FLAG_CY, FLAG_Z, FLAG_S};
+		flagsWrittenByType[FLAG_WRITE_SZ] = {FLAG_Z, FLAG_S};
+		flagsWrittenByType[FLAG_WRITE_OVSZ] = {FLAG_Z, FLAG_S, FLAG_OV};
+		flagsWrittenByType[FLAG_WRITE_CYOVSZ] = {FLAG_Z, FLAG_S, FLAG_OV, FLAG_CY};
+		/* the saturating instructions also set the sticky SAT */
+		flagsWrittenByType[FLAG_WRITE_ALL] = {FLAG_CY, FLAG_Z, FLAG_OV, FLAG_S, FLAG_SAT};
+		flagsWrittenByType[FLAG_WRITE_Z] = {FLAG_Z};
+		flagsWrittenByType[FLAG_WRITE_SZ_OV0] = {FLAG_Z, FLAG_S, FLAG_OV};
+		flagsWrittenByType[FLAG_WRITE_CYSZ_OV0] = {FLAG_CY, FLAG_Z, FLAG_S, FLAG_OV};
+
+		/* with OV known to be 0 the signed conditions reduce to the sign flag,
+		   le has no single condition and falls back to the group IL */
+		allSemanticFlagClasses = {FLAG_CLASS_LOGIC};
+		allSemanticFlagGroups = {FLAG_GROUP_LT, FLAG_GROUP_GE, FLAG_GROUP_LE, FLAG_GROUP_GT};
+		flagsRequiredForGroup[FLAG_GROUP_LT] = {FLAG_S, FLAG_OV};
+		flagsRequiredForGroup[FLAG_GROUP_GE] = {FLAG_S, FLAG_OV};
+		flagsRequiredForGroup[FLAG_GROUP_LE] = {FLAG_S, FLAG_OV, FLAG_Z};
+		flagsRequiredForGroup[FLAG_GROUP_GT] = {FLAG_S, FLAG_OV, FLAG_Z};
+		flagConditionsForGroup[FLAG_GROUP_LT] = {{0, LLFC_SLT}, {FLAG_CLASS_LOGIC, LLFC_NEG}};
+		flagConditionsForGroup[FLAG_GROUP_GE] = {{0, LLFC_SGE}, {FLAG_CLASS_LOGIC, LLFC_POS}};
+		flagConditionsForGroup[FLAG_GROUP_LE] = {{0, LLFC_SLE}};
+		flagConditionsForGroup[FLAG_GROUP_GT] = {{0, LLFC_SGT}};
+
+		for (uint32_t reg = NEC_REG_R0; reg <= NEC_REG_PC; reg++)
+			fullWidthRegisters.push_back(reg);
+		systemRegisters = {
+			NEC_SYSREG_EIPC,
+			NEC_SYSREG_EIPSW,
+			NEC_SYSREG_FEPC,
+			NEC_SYSREG_FEPSW,
+			NEC_SYSREG_PSW,
+			NEC_SYSREG_FPSR,
+			NEC_SYSREG_FPEPC,
+			NEC_SYSREG_FPST,
+			NEC_SYSREG_FPCC,
+			NEC_SYSREG_FPCFG,
+			NEC_SYSREG_FPEC,
+			NEC_SYSREG_EIIC,
+			NEC_SYSREG_FEIC,
+			NEC_SYSREG_CTPC,
+			NEC_SYSREG_CTPSW,
+			NEC_SYSREG_CTBP,
+			NEC_SYSREG_EIWR,
+			NEC_SYSREG_FEWR,
+			NEC_SYSREG_BSEL,
+			NEC_SYSREG_MCFG0,
+			NEC_SYSREG_RBASE,
+			NEC_SYSREG_EBASE,
+			NEC_SYSREG_INTBP,
+			NEC_SYSREG_MCTL,
+			NEC_SYSREG_PID,
+			NEC_SYSREG_SCCFG,
+			NEC_SYSREG_SCBP,
+			NEC_SYSREG_HTCFG0,
+			NEC_SYSREG_MEA,
+			NEC_SYSREG_ASID,
+			NEC_SYSREG_MEI};
+		allRegisters = fullWidthRegisters;
+		allRegisters.insert(allRegisters.end(), systemRegisters.begin(), systemRegisters.end());
+
+		/* every register is its own full-width 32-bit register, ids without a
+		   register keep RegisterInfo(0, 0, 0) */
+		for (BNRegisterInfo &info : registerInfo)
+			info = RegisterInfo(0, 0, 0);
+		for (uint32_t reg : allRegisters)
+			registerInfo[reg] = RegisterInfo(reg, 0, 4);
+
+		for (uint32_t intrinsic = SCH1L_INTRINSIC; intrinsic <= RIE_INTRINSIC; intrinsic++)
+			allIntrinsics.push_back(intrinsic);
+		/* the bit searches take and return a word, the other intrinsics have no operands */
+		for (uint32_t intrinsic : {SCH1L_INTRINSIC, SCH1R_INTRINSIC, SCH0L_INTRINSIC, SCH0R_INTRINSIC})
+		{
+			intrinsicInputs[intrinsic] = {NameAndType("WORD", Type::IntegerType(4, false))};
+			intrinsicOutputs[intrinsic] = {Type::IntegerType(4, false)};
+		}
+
+		for (const LiftRule *&rule : liftRules)
+			rule = NULL;
+		for (const LiftRule &rule : liftTable)
+			liftRules[rule.insnId] = &rule;
+	}
 
-	std::string GetSysregName(int sysreg_id)
+	/* every lookup of every thread so far, including threads that exited */
+	void GetDecodeCacheStats(uint64_t &hits, uint64_t &misses) const
 	{
-		switch (sysreg_id)
+		DecodeCacheRegistry &registry = CacheRegistry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+		hits = registry.exitedHits;
+		misses = registry.exitedMisses;
+		for (const DecodeCache *cache : registry.caches)
 		{
-		case NEC_SYSREG_EIPC:
-			return "eipc";
-		case NEC_SYSREG_EIPSW:
-			return "eipsw";
-		case NEC_SYSREG_FEPC:
-			return "fepc";
-		case NEC_SYSREG_FEPSW:
-			return "fepsw";
-		case NEC_SYSREG_PSW:
-			return "psw";
-		case NEC_SYSREG_FPSR:
-			return "fpsr";
-		case NEC_SYSREG_FPEPC:
-			return "fpepc";
-		case NEC_SYSREG_FPST:
-			return "fpst";
-		case NEC_SYSREG_FPCC:
-			return "fpcc";
-		case NEC_SYSREG_FPCFG:
-			return "fpcfg";
-		case NEC_SYSREG_FPEC:
-			return "fpec";
-		case NEC_SYSREG_EIIC:
-			return "eiic";
-		case NEC_SYSREG_FEIC:
-			return "feic";
-		case NEC_SYSREG_CTPC:
-			return "ctpc";
-		case NEC_SYSREG_CTPSW:
-			return "ctpsw";
-		case NEC_SYSREG_CTBP:
-			return "ctbp";
-		case NEC_SYSREG_EIWR:
-			return "eiwr";
-		case NEC_SYSREG_FEWR:
-			return "fewr";
-		case NEC_SYSREG_BSEL:
-			return "bsel";
-		case NEC_SYSREG_MCFG0:
-			return "mcfg0";
-		case NEC_SYSREG_RBASE:
-			return "rbase";
-		case NEC_SYSREG_EBASE:
-			return "ebase";
-		case NEC_SYSREG_INTBP:
-			return "intbp";
-		case NEC_SYSREG_MCTL:
-			return "mctl";
-		case NEC_SYSREG_PID:
-			return "pid";
-		case NEC_SYSREG_SCCFG:
-			return "sccfg";
-		case NEC_SYSREG_SCBP:
-			return "scbp";
-		case NEC_SYSREG_HTCFG0:
-			return "htcfg0";
-		case NEC_SYSREG_MEA:
-			return "mea";
-		case NEC_SYSREG_ASID:
-			return "asid";
-		case NEC_SYSREG_MEI:
-			return "mei";
-		default:
-			return "INVALID";
+			hits += cache->hits.load(std::memory_order_relaxed);
+			misses += cache->misses.load(std::memory_order_relaxed);
 		}
 	}
 
+	/*************************************************************************/
+
+	const char *GetSysregName(int sysreg_id)
+	{
+		return sysreg_name(sysreg_id);
+	}
+
 	virtual BNEndianness GetEndianness() const override
 	{
 		// MYLOG("%s()\n", __func__);
@@ -203,17 +498,12 @@ public:
 
 	virtual size_t GetMaxInstructionLength() const override
 	{
-		return 8;
+		return INSN_MAX_SIZE;
 	}
 
 	virtual vector<uint32_t> GetAllFlags() override
 	{
-		return vector<uint32_t>{
-			FLAG_SAT,
-			FLAG_CY,
-			FLAG_OV,
-			FLAG_S,
-			FLAG_Z};
+		return allFlags;
 	}
 
 	virtual string GetFlagName(uint32_t flag) override
@@ -237,13 +527,7 @@ public:
 
 	virtual vector<uint32_t> GetAllFlagWriteTypes() override
 	{
-		return vector<uint32_t>{
-			FLAG_WRITE_NONE,
-			FLAG_WRITE_ALL,
-			FLAG_WRITE_OVSZ,
-			FLAG_WRITE_Z,
-			FLAG_WRITE_SZ,
-			FLAG_WRITE_CYSZ};
+		return allFlagWriteTypes;
 	}
 
 	virtual string GetFlagWriteTypeName(uint32_t writeType) override
@@ -262,6 +546,10 @@ public:
 			return "z";
 		case FLAG_WRITE_ALL:
 			return "*";
+		case FLAG_WRITE_SZ_OV0:
+			return "sz.ov0";
+		case FLAG_WRITE_CYSZ_OV0:
+			return "cysz.ov0";
 		default:
 			return "none";
 		}
@@ -269,29 +557,138 @@ public:
 
 	virtual vector<uint32_t> GetFlagsWrittenByFlagWriteType(uint32_t writeType) override
 	{
-		switch (writeType)
+		if (writeType > FLAG_WRITE_CYSZ_OV0)
+			return vector<uint32_t>();
+		return flagsWrittenByType[writeType];
+	}
+
+	virtual uint32_t GetSemanticClassForFlagWriteType(uint32_t writeType) override
+	{
+		if (writeType == FLAG_WRITE_SZ_OV0 || writeType == FLAG_WRITE_CYSZ_OV0)
+			return FLAG_CLASS_LOGIC;
+		return 0;
+	}
+
+	virtual vector<uint32_t> GetAllSemanticFlagClasses() override
+	{
+		return allSemanticFlagClasses;
+	}
+
+	virtual string GetSemanticFlagClassName(uint32_t semClass) override
+	{
+		return semClass == FLAG_CLASS_LOGIC ? "logic" : "";
+	}
+
+	virtual vector<uint32_t> GetAllSemanticFlagGroups() override
+	{
+		return allSemanticFlagGroups;
+	}
+
+	virtual string GetSemanticFlagGroupName(uint32_t semGroup) override
+	{
+		switch (semGroup)
 		{
-		case FLAG_WRITE_CYSZ:
-			return vector<uint32_t>{
-				FLAG_CY, FLAG_Z, FLAG_S};
-		case FLAG_WRITE_SZ:
-			return vector<uint32_t>{
-				FLAG_Z, FLAG_S};
-		case FLAG_WRITE_OVSZ:
-			return vector<uint32_t>{
-				FLAG_Z, FLAG_S, FLAG_OV};
-		case FLAG_WRITE_CYOVSZ:
-			return vector<uint32_t>{
-				FLAG_Z, FLAG_S, FLAG_OV, FLAG_CY};
-		case FLAG_WRITE_ALL:
-			return vector<uint32_t>{
-				FLAG_CY, FLAG_Z, FLAG_OV, FLAG_S};
-		case FLAG_WRITE_Z:
-			return vector<uint32_t>{
-				FLAG_Z};
+		case FLAG_GROUP_LT:
+			return "lt";
+		case FLAG_GROUP_GE:
+			return "ge";
+		case FLAG_GROUP_LE:
+			return "le";
+		case FLAG_GROUP_GT:
+			return "gt";
 		default:
+			return "";
+		}
+	}
+
+	virtual vector<uint32_t> GetFlagsRequiredForSemanticFlagGroup(uint32_t semGroup) override
+	{
+		if (semGroup > FLAG_GROUP_GT)
 			return vector<uint32_t>();
+		return flagsRequiredForGroup[semGroup];
+	}
+
+	virtual std::map<uint32_t, BNLowLevelILFlagCondition> GetFlagConditionsForSemanticFlagGroup(uint32_t semGroup) override
+	{
+		if (semGroup > FLAG_GROUP_GT)
+			return std::map<uint32_t, BNLowLevelILFlagCondition>();
+		return flagConditionsForGroup[semGroup];
+	}
+
+	/* Used when the flags come from writers of different classes. */
+	virtual ExprId GetSemanticFlagGroupLowLevelIL(uint32_t semGroup, LowLevelILFunction &il) override
+	{
+		switch (semGroup)
+		{
+		case FLAG_GROUP_LT:
+			return il.FlagCondition(LLFC_SLT);
+		case FLAG_GROUP_GE:
+			return il.FlagCondition(LLFC_SGE);
+		case FLAG_GROUP_LE:
+			return il.FlagCondition(LLFC_SLE);
+		case FLAG_GROUP_GT:
+			return il.FlagCondition(LLFC_SGT);
+		default:
+			return il.Unimplemented();
+		}
+	}
+
+	ExprId FlagOperand(const BNRegisterOrConstant &operand, size_t size, LowLevelILFunction &il)
+	{
+		if (operand.constant)
+			return il.Const(size, operand.value);
+		return il.Register(size, operand.reg);
+	}
+
+	/* CY of a shift is the last bit shifted out, and 0 when the shift amount,
+	   taken modulo 32, is 0. */
+	ExprId GetShiftCarryLowLevelIL(BNLowLevelILOperation op, size_t size, BNRegisterOrConstant *operands, LowLevelILFunction &il)
+	{
+		const uint64_t bits = size * 8;
+		if (operands[1].constant)
+		{
+			uint64_t amount = operands[1].value & (bits - 1);
+			if (amount == 0)
+				return il.Const(0, 0);
+			uint64_t bit = op == LLIL_LSL ? bits - amount : amount - 1;
+			return il.CompareNotEqual(size, il.And(size, FlagOperand(operands[0], size, il), il.Const(size, (uint64_t)1 << bit)), il.Const(size, 0));
+		}
+		ExprId amount = il.And(size, il.Register(size, operands[1].reg), il.Const(size, bits - 1));
+		ExprId bit = op == LLIL_LSL ?
+			il.Sub(size, il.Const(size, bits), amount) :
+			il.Sub(size, amount, il.Const(size, 1));
+		ExprId carry = il.CompareNotEqual(size,
+			il.And(size, il.LogicalShiftRight(size, FlagOperand(operands[0], size, il), bit), il.Const(size, 1)),
+			il.Const(size, 0));
+		ExprId shifted = il.CompareNotEqual(size,
+			il.And(size, il.Register(size, operands[1].reg), il.Const(size, bits - 1)),
+			il.Const(size, 0));
+		return il.And(0, shifted, carry);
+	}
+
+	/* Flags are computed lazily from the flag write type of the operation, only
+	   the ones that are read survive dataflow. */
+	virtual ExprId GetFlagWriteLowLevelIL(BNLowLevelILOperation op, size_t size, uint32_t flagWriteType, uint32_t flag,
+		BNRegisterOrConstant *operands, size_t operandCount, LowLevelILFunction &il) override
+	{
+		switch (flag)
+		{
+		case FLAG_OV:
+			if (GetSemanticClassForFlagWriteType(flagWriteType) == FLAG_CLASS_LOGIC)
+				return il.Const(0, 0);
+			break;
+		case FLAG_CY:
+			if ((op == LLIL_LSL || op == LLIL_LSR || op == LLIL_ASR) && operandCount == 2)
+				return GetShiftCarryLowLevelIL(op, size, operands, il);
+			break;
+		case FLAG_SAT:
+			/* sticky, set when the result saturated */
+			return il.Or(0, il.Flag(FLAG_SAT),
+				GetDefaultFlagWriteLowLevelIL(op, size, OverflowFlagRole, operands, operandCount, il));
+		default:
+			break;
 		}
+		return Architecture::GetFlagWriteLowLevelIL(op, size, flagWriteType, flag, operands, operandCount, il);
 	}
 
 	virtual BNFlagRole GetFlagRole(uint32_t flag, uint32_t semClass) override
@@ -356,95 +753,17 @@ public:
 
 	virtual vector<uint32_t> GetFullWidthRegisters() override
 	{
-
-		return vector<uint32_t>{
-			NEC_REG_R0, NEC_REG_R1, NEC_REG_R2, NEC_REG_SP, NEC_REG_R4, NEC_REG_R5, NEC_REG_R6, NEC_REG_R7,
-			NEC_REG_R8, NEC_REG_R9, NEC_REG_R10, NEC_REG_R11, NEC_REG_R12, NEC_REG_R13, NEC_REG_R14, NEC_REG_R15,
-			NEC_REG_R16, NEC_REG_R17, NEC_REG_R18, NEC_REG_R19, NEC_REG_R20, NEC_REG_R21, NEC_REG_R22, NEC_REG_R23,
-			NEC_REG_R24, NEC_REG_R25, NEC_REG_R26, NEC_REG_R27, NEC_REG_R28, NEC_REG_R29, NEC_REG_EP, NEC_REG_LP, NEC_REG_PC};
+		return fullWidthRegisters;
 	}
 
 	virtual vector<uint32_t> GetAllRegisters() override
 	{
-		vector<uint32_t> result = {
-			NEC_REG_R0, NEC_REG_R1, NEC_REG_R2, NEC_REG_SP, NEC_REG_R4, NEC_REG_R5, NEC_REG_R6, NEC_REG_R7,
-			NEC_REG_R8, NEC_REG_R9, NEC_REG_R10, NEC_REG_R11, NEC_REG_R12, NEC_REG_R13, NEC_REG_R14, NEC_REG_R15,
-			NEC_REG_R16, NEC_REG_R17, NEC_REG_R18, NEC_REG_R19, NEC_REG_R20, NEC_REG_R21, NEC_REG_R22, NEC_REG_R23,
-			NEC_REG_R24, NEC_REG_R25, NEC_REG_R26, NEC_REG_R27, NEC_REG_R28, NEC_REG_R29, NEC_REG_EP, NEC_REG_LP, NEC_REG_PC,
-			// system registers
-			NEC_SYSREG_EIPC,
-			NEC_SYSREG_EIPSW,
-			NEC_SYSREG_FEPC,
-			NEC_SYSREG_FEPSW,
-			NEC_SYSREG_PSW,
-			NEC_SYSREG_FPSR,
-			NEC_SYSREG_FPEPC,
-			NEC_SYSREG_FPST,
-			NEC_SYSREG_FPCC,
-			NEC_SYSREG_FPCFG,
-			NEC_SYSREG_FPEC,
-			NEC_SYSREG_EIIC,
-			NEC_SYSREG_FEIC,
-			NEC_SYSREG_CTPC,
-			NEC_SYSREG_CTPSW,
-			NEC_SYSREG_CTBP,
-			NEC_SYSREG_EIWR,
-			NEC_SYSREG_FEWR,
-			NEC_SYSREG_BSEL,
-			NEC_SYSREG_MCFG0,
-			NEC_SYSREG_RBASE,
-			NEC_SYSREG_EBASE,
-			NEC_SYSREG_INTBP,
-			NEC_SYSREG_MCTL,
-			NEC_SYSREG_PID,
-			NEC_SYSREG_SCCFG,
-			NEC_SYSREG_SCBP,
-			NEC_SYSREG_HTCFG0,
-			NEC_SYSREG_MEA,
-			NEC_SYSREG_ASID,
-			NEC_SYSREG_MEI};
-
-		return result;
+		return allRegisters;
 	}
 
 	virtual vector<uint32_t> GetSystemRegisters() override
 	{
-		vector<uint32_t> result = {
-			NEC_SYSREG_EIPC,
-			NEC_SYSREG_EIPSW,
-			NEC_SYSREG_FEPC,
-			NEC_SYSREG_FEPSW,
-			NEC_SYSREG_PSW,
-			NEC_SYSREG_FPSR,
-			NEC_SYSREG_FPEPC,
-			NEC_SYSREG_FPST,
-			NEC_SYSREG_FPCC,
-			NEC_SYSREG_FPCFG,
-			NEC_SYSREG_FPEC,
-			NEC_SYSREG_EIIC,
-			NEC_SYSREG_FEIC,
-			NEC_SYSREG_CTPC,
-			NEC_SYSREG_CTPSW,
-			NEC_SYSREG_CTBP,
-			NEC_SYSREG_EIWR,
-			NEC_SYSREG_FEWR,
-			NEC_SYSREG_BSEL,
-			NEC_SYSREG_MCFG0,
-			NEC_SYSREG_RBASE,
-			NEC_SYSREG_EBASE,
-			NEC_SYSREG_INTBP,
-			NEC_SYSREG_MCTL,
-			NEC_SYSREG_PID,
-			NEC_SYSREG_SCCFG,
-			NEC_SYSREG_SCBP,
-			NEC_SYSREG_HTCFG0,
-			NEC_SYSREG_MEA,
-			NEC_SYSREG_ASID,
-			NEC_SYSREG_MEI
-
-		};
-
-		return result;
+		return systemRegisters;
 	}
 
 	virtual std::vector<uint32_t> GetGlobalRegisters() override
@@ -459,7 +778,7 @@ public:
 		if (regId >= NEC_REG_R0 && regId <= NEC_REG_PC)
 			result = reg_name[regId];
 		else if (regId >= NEC_SYSREG_EIPC && regId <= NEC_SYSREG_MEI)
-			return GetSysregName(regId);
+			result = GetSysregName(regId);
 		else
 			result = "";
 		return result;
@@ -472,167 +791,295 @@ public:
 			return il.Register(size, reg_id);
 	}
 
-	virtual BNRegisterInfo GetRegisterInfo(uint32_t regId) override
+	/* Both successors of a Bcond are usually block starts of the function being
+	   lifted, so they already have labels and the branch is a single If. Only a
+	   target without a label needs its own Jump. */
+	void ConditionalBranch(LowLevelILFunction &il, ExprId condition, uint64_t target, uint64_t next)
 	{
-		switch (regId)
+		BNLowLevelILLabel *trueLabel = il.GetLabelForAddress(this, target);
+		BNLowLevelILLabel *falseLabel = il.GetLabelForAddress(this, next);
+		LowLevelILLabel trueCode, falseCode;
+
+		il.AddInstruction(il.If(condition, trueLabel ? *trueLabel : trueCode, falseLabel ? *falseLabel : falseCode));
+		if (!trueLabel)
 		{
-			// BNRegisterInfo RegisterInfo(uint32_t fullWidthReg, size_t offset,
-			//   size_t size, bool zeroExtend = false)
-
-		case NEC_REG_R0:
-			return RegisterInfo(NEC_REG_R0, 0, 4);
-		case NEC_REG_R1:
-			return RegisterInfo(NEC_REG_R1, 0, 4);
-		case NEC_REG_R2:
-			return RegisterInfo(NEC_REG_R2, 0, 4);
-		case NEC_REG_SP:
-			return RegisterInfo(NEC_REG_SP, 0, 4);
-		case NEC_REG_R4:
-			return RegisterInfo(NEC_REG_R4, 0, 4);
-		case NEC_REG_R5:
-			return RegisterInfo(NEC_REG_R5, 0, 4);
-		case NEC_REG_R6:
-			return RegisterInfo(NEC_REG_R6, 0, 4);
-		case NEC_REG_R7:
-			return RegisterInfo(NEC_REG_R7, 0, 4);
-		case NEC_REG_R8:
-			return RegisterInfo(NEC_REG_R8, 0, 4);
-		case NEC_REG_R9:
-			return RegisterInfo(NEC_REG_R9, 0, 4);
-		case NEC_REG_R10:
-			return RegisterInfo(NEC_REG_R10, 0, 4);
-		case NEC_REG_R11:
-			return RegisterInfo(NEC_REG_R11, 0, 4);
-		case NEC_REG_R12:
-			return RegisterInfo(NEC_REG_R12, 0, 4);
-		case NEC_REG_R13:
-			return RegisterInfo(NEC_REG_R13, 0, 4);
-		case NEC_REG_R14:
-			return RegisterInfo(NEC_REG_R14, 0, 4);
-		case NEC_REG_R15:
-			return RegisterInfo(NEC_REG_R15, 0, 4);
-		case NEC_REG_R16:
-			return RegisterInfo(NEC_REG_R16, 0, 4);
-		case NEC_REG_R17:
-			return RegisterInfo(NEC_REG_R17, 0, 4);
-		case NEC_REG_R18:
-			return RegisterInfo(NEC_REG_R18, 0, 4);
-		case NEC_REG_R19:
-			return RegisterInfo(NEC_REG_R19, 0, 4);
-		case NEC_REG_R20:
-			return RegisterInfo(NEC_REG_R20, 0, 4);
-		case NEC_REG_R21:
-			return RegisterInfo(NEC_REG_R21, 0, 4);
-		case NEC_REG_R22:
-			return RegisterInfo(NEC_REG_R22, 0, 4);
-		case NEC_REG_R23:
-			return RegisterInfo(NEC_REG_R23, 0, 4);
-		case NEC_REG_R24:
-			return RegisterInfo(NEC_REG_R24, 0, 4);
-		case NEC_REG_R25:
-			return RegisterInfo(NEC_REG_R25, 0, 4);
-		case NEC_REG_R26:
-			return RegisterInfo(NEC_REG_R26, 0, 4);
-		case NEC_REG_R27:
-			return RegisterInfo(NEC_REG_R27, 0, 4);
-		case NEC_REG_R28:
-			return RegisterInfo(NEC_REG_R28, 0, 4);
-		case NEC_REG_EP:
-			return RegisterInfo(NEC_REG_EP, 0, 4);
-		case NEC_REG_LP:
-			return RegisterInfo(NEC_REG_LP, 0, 4);
-		case NEC_REG_PC:
-			return RegisterInfo(NEC_REG_PC, 0, 4);
-		case NEC_SYSREG_EIPC:
-			return RegisterInfo(NEC_SYSREG_EIPC, 0, 4);
-		case NEC_SYSREG_EIPSW:
-			return RegisterInfo(NEC_SYSREG_EIPSW, 0, 4);
-		case NEC_SYSREG_FEPC:
-			return RegisterInfo(NEC_SYSREG_FEPC, 0, 4);
-		case NEC_SYSREG_FEPSW:
-			return RegisterInfo(NEC_SYSREG_FEPSW, 0, 4);
-		case NEC_SYSREG_PSW:
-			return RegisterInfo(NEC_SYSREG_PSW, 0, 4);
-		case NEC_SYSREG_FPSR:
-			return RegisterInfo(NEC_SYSREG_FPSR, 0, 4);
-		case NEC_SYSREG_FPEPC:
-			return RegisterInfo(NEC_SYSREG_FPEPC, 0, 4);
-		case NEC_SYSREG_FPST:
-			return RegisterInfo(NEC_SYSREG_FPST, 0, 4);
-		case NEC_SYSREG_FPCC:
-			return RegisterInfo(NEC_SYSREG_FPCC, 0, 4);
-		case NEC_SYSREG_FPCFG:
-			return RegisterInfo(NEC_SYSREG_FPCFG, 0, 4);
-		case NEC_SYSREG_FPEC:
-			return RegisterInfo(NEC_SYSREG_FPEC, 0, 4);
-		case NEC_SYSREG_EIIC:
-			return RegisterInfo(NEC_SYSREG_EIIC, 0, 4);
-		case NEC_SYSREG_FEIC:
-			return RegisterInfo(NEC_SYSREG_FEIC, 0, 4);
-		case NEC_SYSREG_CTPC:
-			return RegisterInfo(NEC_SYSREG_CTPC, 0, 4);
-		case NEC_SYSREG_CTPSW:
-			return RegisterInfo(NEC_SYSREG_CTPSW, 0, 4);
-		case NEC_SYSREG_CTBP:
-			return RegisterInfo(NEC_SYSREG_CTBP, 0, 4);
-		case NEC_SYSREG_EIWR:
-			return RegisterInfo(NEC_SYSREG_EIWR, 0, 4);
-		case NEC_SYSREG_FEWR:
-			return RegisterInfo(NEC_SYSREG_FEWR, 0, 4);
-		case NEC_SYSREG_BSEL:
-			return RegisterInfo(NEC_SYSREG_BSEL, 0, 4);
-		case NEC_SYSREG_MCFG0:
-			return RegisterInfo(NEC_SYSREG_MCFG0, 0, 4);
-		case NEC_SYSREG_RBASE:
-			return RegisterInfo(NEC_SYSREG_RBASE, 0, 4);
-		case NEC_SYSREG_EBASE:
-			return RegisterInfo(NEC_SYSREG_EBASE, 0, 4);
-		case NEC_SYSREG_INTBP:
-			return RegisterInfo(NEC_SYSREG_INTBP, 0, 4);
-		case NEC_SYSREG_MCTL:
-			return RegisterInfo(NEC_SYSREG_MCTL, 0, 4);
-		case NEC_SYSREG_PID:
-			return RegisterInfo(NEC_SYSREG_PID, 0, 4);
-		case NEC_SYSREG_SCCFG:
-			return RegisterInfo(NEC_SYSREG_SCCFG, 0, 4);
-		case NEC_SYSREG_SCBP:
-			return RegisterInfo(NEC_SYSREG_SCBP, 0, 4);
-		case NEC_SYSREG_HTCFG0:
-			return RegisterInfo(NEC_SYSREG_HTCFG0, 0, 4);
-		case NEC_SYSREG_MEA:
-			return RegisterInfo(NEC_SYSREG_MEA, 0, 4);
-		case NEC_SYSREG_ASID:
-			return RegisterInfo(NEC_SYSREG_ASID, 0, 4);
-		case NEC_SYSREG_MEI:
-			return RegisterInfo(NEC_SYSREG_MEI, 0, 4);
-		default:
-			// LogError("%s(%d == \"%s\") invalid argument", __func__,
-			//   regId, powerpc_reg_to_str(regId));
-			return RegisterInfo(0, 0, 0);
+			il.MarkLabel(trueCode);
+			il.AddInstruction(il.Jump(il.ConstPointer(4, target)));
 		}
+		/* the not-taken path falls through to the next instruction */
+		if (!falseLabel)
+			il.MarkLabel(falseCode);
 	}
 
-	virtual uint32_t GetStackPointerRegister() override
+	void Branch(LowLevelILFunction &il, uint64_t target)
 	{
-		return NEC_REG_SP;
+		BNLowLevelILLabel *label = il.GetLabelForAddress(this, target);
+		if (label)
+			il.AddInstruction(il.Goto(*label));
+		else
+			il.AddInstruction(il.Jump(il.ConstPointer(4, target)));
 	}
 
-	virtual uint32_t GetLinkRegister() override
+	ExprId LiftOperand(LowLevelILFunction &il, const insn_t *insn, const LiftSource &source)
 	{
-		return NEC_REG_LP;
+		ExprId value;
+		if (source.kind == LIFT_IMM)
+			value = il.Const(source.size, insn->fields[source.field].value);
+		else
+			value = get_reg(il, insn->fields[source.field].value, source.size);
+		if (source.ext != LLIL_NOP)
+			value = il.AddExpr(source.ext, 4, 0, value);
+		return value;
 	}
 
+	ExprId LiftAddress(LowLevelILFunction &il, const insn_t *insn, const LiftRule &rule)
+	{
+		if (rule.b.kind == LIFT_NONE)
+			return LiftOperand(il, insn, rule.a);
+		return il.Add(4, LiftOperand(il, insn, rule.a), LiftOperand(il, insn, rule.b));
+	}
 
-virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
-         switch (intrinsic)  {
-            case SCH1L_INTRINSIC:
-                return "_CountLeadingZeros";
-            case SCH1R_INTRINSIC:
-                return "_CountTrailingZeros";
-            case SCH0L_INTRINSIC:
-                return "_CountLeadingOnes";
-			case SCH0R_INTRINSIC:
-                return "_CountTrailingOnes";
+	/* Builds the IL of an instruction described by liftTable. */
+	void LiftFromRule(LowLevelILFunction &il, const insn_t *insn, const LiftRule &rule)
+	{
+		ExprId value;
+		switch (rule.form)
+		{
+		case LIFT_SET:
+			if (rule.op == LLIL_NOP)
+			{
+				il.AddInstruction(il.SetRegister(4, insn->fields[rule.dest].value, LiftOperand(il, insn, rule.a), rule.flags));
+				break;
+			}
+			value = il.AddExpr(rule.op, rule.size, rule.flags, LiftOperand(il, insn, rule.a),
+				rule.b.kind == LIFT_NONE ? 0 : LiftOperand(il, insn, rule.b));
+			il.AddInstruction(il.SetRegister(4, insn->fields[rule.dest].value, value));
+			break;
+		case LIFT_COMPARE:
+			il.AddInstruction(il.AddExpr(rule.op, rule.size, rule.flags, LiftOperand(il, insn, rule.a), LiftOperand(il, insn, rule.b)));
+			break;
+		case LIFT_LOAD:
+			value = il.Load(rule.size, LiftAddress(il, insn, rule));
+			if (rule.op != LLIL_NOP)
+				value = il.AddExpr(rule.op, 4, 0, value);
+			il.AddInstruction(il.SetRegister(4, insn->fields[rule.dest].value, value));
+			break;
+		case LIFT_STORE:
+			il.AddInstruction(il.Store(rule.size, LiftAddress(il, insn, rule), LiftOperand(il, insn, rule.c)));
+			break;
+		case LIFT_INTRINSIC:
+			il.AddInstruction(il.Intrinsic({}, rule.intrinsic, {}));
+			break;
+		}
+	}
+
+	/* prepare pushes the listed registers from r20 up, then allocates imm5
+	   words of frame */
+	void Prepare(LowLevelILFunction &il, const insn_t *insn)
+	{
+		for (uint32_t i = 0; i < 12; i++)
+			if ((insn->fields[0].value >> list12Bit[i]) & 1)
+				il.AddInstruction(il.Push(4, il.Register(4, NEC_REG_R20 + i)));
+		il.AddInstruction(il.SetRegister(4, NEC_REG_SP,
+			il.Sub(4, il.Register(4, NEC_REG_SP), il.Const(4, insn->fields[1].value))));
+	}
+
+	/* dispose undoes it, the [reg] form then jumps through reg, which is
+	   the return of a function that saved lp */
+	void Dispose(LowLevelILFunction &il, const insn_t *insn)
+	{
+		il.AddInstruction(il.SetRegister(4, NEC_REG_SP,
+			il.Add(4, il.Register(4, NEC_REG_SP), il.Const(4, insn->fields[0].value))));
+		for (uint32_t i = 12; i-- > 0;)
+			if ((insn->fields[1].value >> list12Bit[i]) & 1)
+				il.AddInstruction(il.SetRegister(4, NEC_REG_R20 + i, il.Pop(4)));
+		if (insn->insn_id != N850_DISPOSER)
+			return;
+		if (insn->fields[2].value == NEC_REG_LP)
+			il.AddInstruction(il.Return(il.Register(4, NEC_REG_LP)));
+		else
+			il.AddInstruction(il.Jump(il.Register(4, insn->fields[2].value)));
+	}
+
+	/* Entries of a table guarded by cmp bound, reg and a bh default, or a bnl
+	   when the bound is the case count. 0 for a bound that is out of range. */
+	static uint32_t GuardedCaseCount(uint8_t cond, uint32_t bound)
+	{
+		if (bound >= SWITCH_MAX_CASES)
+			return 0;
+		return cond == COND_H ? bound + 1 : bound;
+	}
+
+	/* The distinct targets of count table entries at table, which are signed
+	   halfword offsets from the table. */
+	static void TableTargets(const uint8_t *entries, uint32_t count, uint64_t table, std::vector<uint64_t> &targets)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			int16_t offset = (int16_t)(entries[2 * i + 1] << 8 | entries[2 * i]);
+			targets.push_back((table + ((int64_t)offset << 1)) & 0xffffffff);
+		}
+		sort(targets.begin(), targets.end());
+		targets.erase(unique(targets.begin(), targets.end()), targets.end());
+	}
+
+	/* Compilers bound a switch with cmp bound, reg and bh default right in
+	   front of it (bnl when the bound is the case count), the bound being an
+	   imm5 or a register loaded by the mov/movea just before the cmp. Returns
+	   the number of table entries, 0 when there is no such guard. */
+	uint32_t SwitchCaseCount(BinaryView *view, uint64_t addr, int32_t reg)
+	{
+		static const uint8_t loadSizes[] = {2, 4, 6};
+		uint8_t before[12];
+		insn_t guard, cmp, load;
+		uint32_t bound;
+
+		if (addr < sizeof(before) || view->Read(before, addr - sizeof(before), sizeof(before)) != sizeof(before))
+			return 0;
+		if (disassemble_into(before + 10, 2, &guard) != DISASS_OK || guard.op_type != OP_TYPE_CJMP
+			|| (guard.cond != COND_H && guard.cond != COND_NL))
+			return 0;
+		if (disassemble_into(before + 8, 2, &cmp) != DISASS_OK || cmp.fields[1].value != reg)
+			return 0;
+		if (cmp.insn_id == N850_CMPI)
+			bound = (uint32_t)cmp.fields[0].value;
+		else if (cmp.insn_id != N850_CMP)
+			return 0;
+		else
+		{
+			size_t i;
+			for (i = 0; i < sizeof(loadSizes); i++)
+			{
+				uint8_t size = loadSizes[i];
+				if (disassemble_into(before + 8 - size, size, &load) != DISASS_OK || load.size != size)
+					continue;
+				if ((load.insn_id == N850_MOVI5 || load.insn_id == N850_MOVI) && load.fields[1].value == cmp.fields[0].value)
+					break;
+				if (load.insn_id == N850_MOVEA && load.fields[1].value == NEC_REG_R0 && load.fields[2].value == cmp.fields[0].value)
+					break;
+			}
+			if (i == sizeof(loadSizes))
+				return 0;
+			bound = (uint32_t)load.fields[0].value;
+		}
+		return GuardedCaseCount(guard.cond, bound);
+	}
+
+	/* The targets of the guarded table at addr + 2. False when the guard is
+	   not recognised or the table leaves the executable part of the view. */
+	bool SwitchTargets(BinaryView *view, uint64_t addr, int32_t reg, std::vector<uint64_t> &targets)
+	{
+		uint32_t count = SwitchCaseCount(view, addr, reg);
+		uint64_t table = addr + 2;
+		uint8_t entries[SWITCH_MAX_CASES * 2];
+
+		if (count == 0 || view->Read(entries, table, count * 2) != count * 2)
+			return false;
+		TableTargets(entries, count, table, targets);
+		for (uint64_t target : targets)
+			if (!view->IsOffsetExecutable(target))
+				return false;
+		return true;
+	}
+
+	/* The targets of a switch are the function's indirect branches for it,
+	   which ResolveSwitchTables (or the user) sets. Once every target is a
+	   block start the switch lifts to a JumpTo over them, until then to a
+	   Jump that Binary Ninja's dataflow may still resolve. Lifting only reads
+	   the function, it never changes it. */
+	void Switch(LowLevelILFunction &il, const insn_t *insn, uint64_t addr)
+	{
+		ExprId table = il.Const(4, addr + 2);
+		ExprId dest = il.Add(4, table,
+			il.ShiftLeft(4, il.SignExtend(4,
+				il.Load(2, il.Add(4, table, il.ShiftLeft(4, get_reg(il, insn->fields[0].value, 4), il.Const(4, 1))))),
+				il.Const(4, 1)));
+		Ref<Function> func = il.GetFunction();
+		std::map<uint64_t, BNLowLevelILLabel *> labels;
+
+		if (func)
+		{
+			for (const IndirectBranchInfo &branch : func->GetIndirectBranchesAt(this, addr))
+			{
+				BNLowLevelILLabel *label = il.GetLabelForAddress(branch.destArch, branch.destAddr);
+				if (!label)
+				{
+					labels.clear();
+					break;
+				}
+				labels[branch.destAddr] = label;
+			}
+		}
+		if (labels.empty())
+			il.AddInstruction(il.Jump(dest));
+		else
+			il.AddInstruction(il.JumpTo(dest, labels));
+	}
+
+	/* Sets the table targets of every guarded switch that the analysis of
+	   view left with undetermined edges as the auto indirect branches of its
+	   function, which makes Binary Ninja reanalyse those functions with the
+	   targets as block starts. Switches that already have indirect branches
+	   (user-set or from an earlier run) are left alone, so running it again
+	   only picks up switches found since. Returns the number of switches. */
+	size_t ResolveSwitchTables(BinaryView *view)
+	{
+		size_t resolved = 0;
+		for (auto &function : view->GetAnalysisFunctionList())
+		{
+			for (auto &block : function->GetBasicBlocks())
+			{
+				uint64_t addr = block->GetEnd() - 2;
+				uint8_t bytes[2];
+				insn_t insn;
+				std::vector<uint64_t> targets;
+
+				if (!block->HasUndeterminedOutgoingEdges() || block->GetArchitecture() != this
+					|| block->GetEnd() < block->GetStart() + 2 || view->Read(bytes, addr, 2) != 2)
+					continue;
+				if (disassemble_into(bytes, 2, &insn) != DISASS_OK || insn.insn_id != N850_SWITCH)
+					continue;
+				if (!function->GetIndirectBranchesAt(this, addr).empty()
+					|| !SwitchTargets(view, addr, insn.fields[0].value, targets))
+					continue;
+				std::vector<ArchAndAddr> branches;
+				for (uint64_t target : targets)
+					branches.emplace_back(this, target);
+				function->SetAutoIndirectBranches(this, addr, branches);
+				resolved++;
+			}
+		}
+		return resolved;
+	}
+
+	virtual BNRegisterInfo GetRegisterInfo(uint32_t regId) override
+	{
+		if (regId > NEC_SYSREG_MEI)
+			return RegisterInfo(0, 0, 0);
+		return registerInfo[regId];
+	}
+
+	virtual uint32_t GetStackPointerRegister() override
+	{
+		return NEC_REG_SP;
+	}
+
+	virtual uint32_t GetLinkRegister() override
+	{
+		return NEC_REG_LP;
+	}
+
+
+virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
+         switch (intrinsic)  {
+            case SCH1L_INTRINSIC:
+                return "_CountLeadingZeros";
+            case SCH1R_INTRINSIC:
+                return "_CountTrailingZeros";
+            case SCH0L_INTRINSIC:
+                return "_CountLeadingOnes";
+			case SCH0R_INTRINSIC:
+                return "_CountTrailingOnes";
 			case SYNC_MEMORY_ACCESS:
                 return "_SynchornizeMemoryAccess";
 			case SYNC_PIPELINE:
@@ -659,185 +1106,38 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
     }
 
     virtual std::vector<uint32_t> GetAllIntrinsics() override {
-        return vector<uint32_t> {
-            SCH1L_INTRINSIC,
-			SCH1R_INTRINSIC,
-			SCH0L_INTRINSIC,
-			SCH0R_INTRINSIC,
-			SYNC_MEMORY_ACCESS,
-			SYNC_PIPELINE,
-			SYNC_INSN_FETCHER,
-			SYNC_EXCEPTIONS,
-			CLL_INTRINSIC,
-			SNOOZE_INTRINSIC,
-			DI_INTRINSIC,
-			EI_INTRINSIC,
-			HALT_INTRINSIC,
-			RIE_INTRINSIC
-        };
+        return allIntrinsics;
     }
 
     virtual std::vector<NameAndType> GetIntrinsicInputs (uint32_t intrinsic) override {
-        switch (intrinsic)
-            {
-                case SCH1L_INTRINSIC:
-                    return {
-                        NameAndType("WORD", Type::IntegerType(4, false))
-                    };
-                case SCH1R_INTRINSIC:
-                    return {
-                        NameAndType("WORD", Type::IntegerType(4, false))
-                    };
-                case SCH0L_INTRINSIC:
-                    return {
-                        NameAndType("WORD", Type::IntegerType(4, false))
-                    };
-				case SCH0R_INTRINSIC:
-                    return {
-                        NameAndType("WORD", Type::IntegerType(4, false))
-                    };
-				case SYNC_MEMORY_ACCESS:
-                    return {  };
-				case SYNC_PIPELINE:
-                    return {  };
-				case SYNC_INSN_FETCHER:
-                    return {  };
-				case SYNC_EXCEPTIONS:
-                    return {  };
-				case CLL_INTRINSIC:
-                    return { };
-				case SNOOZE_INTRINSIC:
-                    return { };
-				case DI_INTRINSIC:
-                    return {  };
-				case EI_INTRINSIC:
-                    return {  };
-				case HALT_INTRINSIC:
-                    return {  };
-				case RIE_INTRINSIC:
-                    return {  };
-                default:
-                    return vector<NameAndType>();
-            }
+        if (intrinsic > RIE_INTRINSIC)
+            return vector<NameAndType>();
+        return intrinsicInputs[intrinsic];
     }
 
     virtual std::vector<Confidence<Ref<Type>>> GetIntrinsicOutputs (uint32_t intrinsic) override {
-        switch (intrinsic)
-            {
-                case SCH1L_INTRINSIC:
-                    return { Type::IntegerType(4, false) };
-                case SCH1R_INTRINSIC:
-                    return { Type::IntegerType(4, false) };
-				case SCH0L_INTRINSIC:
-                    return { Type::IntegerType(4, false) };
-				case SCH0R_INTRINSIC:
-                    return { Type::IntegerType(4, false) };
-				case SYNC_MEMORY_ACCESS:
-                    return { };
-				case SYNC_PIPELINE:
-                    return { };
-				case SYNC_INSN_FETCHER:
-                    return { };
-				case SYNC_EXCEPTIONS:
-                    return { };
-				case CLL_INTRINSIC:
-                    return { };
-				case SNOOZE_INTRINSIC:
-                    return { };
-				case DI_INTRINSIC:
-                    return {  };
-				case EI_INTRINSIC:
-                    return {  };
-				case HALT_INTRINSIC:
-                    return {  };
-				case RIE_INTRINSIC:
-                    return {  };
-                default:
-                    return vector<Confidence<Ref<Type>>>();
-            }
+        if (intrinsic > RIE_INTRINSIC)
+            return vector<Confidence<Ref<Type>>>();
+        return intrinsicOutputs[intrinsic];
     }
 
 	virtual bool GetInstructionLowLevelIL(const uint8_t *data, uint64_t addr, size_t &len, LowLevelILFunction &il) override
 	{
-		insn_t *insn;
-		if ((insn = disassemble(data)))
+		const insn_t *insn = Decode(data, addr, len);
+		if (insn)
 		{
 			len = insn->size;
-			BNLowLevelILLabel *true_label = NULL;
-			BNLowLevelILLabel *false_label = NULL;
+			if (liftRules[insn->insn_id])
+			{
+				LiftFromRule(il, insn, *liftRules[insn->insn_id]);
+				return true;
+			}
 			LowLevelILLabel true_tag;
 			LowLevelILLabel false_tag;
 			LowLevelILLabel end_tag;
 			ExprId condition;
 			switch (insn->insn_id)
 			{
-			case N850_ABSFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatAbs(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_ADD:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYOVSZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_ADD_IMM:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									1,
-									insn->fields[0].value
-								)
-							),
-							FLAG_WRITE_CYOVSZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_ADDFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatAdd(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
 			case N850_ADF:
 			{
 				if (insn->fields[0].value == 5) {
@@ -890,16 +1190,16 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 						condition = il.FlagCondition(LLFC_UGE);
 						break;
 					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
+						condition = il.FlagGroup(FLAG_GROUP_LT);
 						break;
 					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
+						condition = il.FlagGroup(FLAG_GROUP_GE);
 						break;
 					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
+						condition = il.FlagGroup(FLAG_GROUP_LE);
 						break;
 					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
+						condition = il.FlagGroup(FLAG_GROUP_GT);
 						break;
 					case 4:
 						condition = il.FlagCondition(LLFC_NEG);
@@ -954,2432 +1254,356 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				
 			}
 			break;
-			case N850_ADDI:
+			case N850_BGE:
+				ConditionalBranch(il, il.FlagGroup(FLAG_GROUP_GE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BGT:
+				ConditionalBranch(il, il.FlagGroup(FLAG_GROUP_GT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BLE:
+				ConditionalBranch(il, il.FlagGroup(FLAG_GROUP_LE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BLT:
+				ConditionalBranch(il, il.FlagGroup(FLAG_GROUP_LT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BH:
+				ConditionalBranch(il, il.FlagCondition(LLFC_UGT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BL:
+				ConditionalBranch(il, il.FlagCondition(LLFC_ULT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNH:
+				ConditionalBranch(il, il.FlagCondition(LLFC_ULE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNL:
+				ConditionalBranch(il, il.FlagCondition(LLFC_UGE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BE:
+				ConditionalBranch(il, il.FlagCondition(LLFC_E), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNE:
+				ConditionalBranch(il, il.FlagCondition(LLFC_NE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BC:
+				ConditionalBranch(il, il.FlagCondition(LLFC_ULT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BN:
+				ConditionalBranch(il, il.FlagCondition(LLFC_NEG), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNC:
+				ConditionalBranch(il, il.FlagCondition(LLFC_UGE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNV:
+				ConditionalBranch(il, il.FlagCondition(LLFC_NO), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BNZ:
+				ConditionalBranch(il, il.FlagCondition(LLFC_NE), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BP:
+				ConditionalBranch(il, il.FlagCondition(LLFC_POS), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BR:
+				Branch(il, (uint32_t)(addr + insn->fields[0].value));
+				break;
+			case N850_BSA:
+				ConditionalBranch(il, il.Flag(FLAG_SAT), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BV:
+				ConditionalBranch(il, il.FlagCondition(LLFC_O), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BZ:
+				ConditionalBranch(il, il.FlagCondition(LLFC_E), (uint32_t)(addr + insn->fields[0].value), (uint32_t)(addr + insn->size));
+				break;
+			case N850_BSH:
 			{
+				// TODO test
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.Add(
+						insn->fields[1].value,
+						il.Or(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
+							il.Or(
 								4,
-								il.Const(
-									2,
-									insn->fields[0].value
+								il.ShiftLeft(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
+								),
+								il.LogicalShiftRight(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff00
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
 								)
+
 							),
-							FLAG_WRITE_CYOVSZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_AND:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.And(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
+							il.Or(
+								4,
+								il.LogicalShiftRight(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff000000
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
+								),
+								il.ShiftLeft(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff0000
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
+								)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_ANDI:
+			case N850_BINS:
 			{
+				// TODO check disassembly again
+				// 🚫001ac798  bins          r29, 0x10, 0x8, r8
+				// 🚫001ac798  bins          r29, 0x10, 0x7, r8
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.And(
+						insn->fields[3].value,
+						il.Or(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
+							il.And(
 								4,
+								this->get_reg(il,insn->fields[3].value,4),
 								il.Const(
-									2,
-									insn->fields[0].value
+									4,
+									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
 								)
 							),
-							FLAG_WRITE_SZ
+							il.And(
+								4,
+								this->get_reg(il,insn->fields[0].value,4),
+								il.Const(
+									4,
+									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
+								)
+							)
 						)
 					)
 				);
+			}
+			break;
+			case N850_BINS2:
+			{
+				// 🚫0012ab84  bins          r2, 0xf, 0x3, r1
+				// 🚫0012ab84  bins          r2, 0xf, 0x1, r1 - RAW
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						insn->fields[3].value,
+						il.Or(
 							4,
-							0
+							il.And(
+								4,
+								this->get_reg(il,insn->fields[3].value,4),
+								il.Const(
+									4,
+									//(0xffffffff << (insn->fields[1].value + insn->fields[2].value - 1)) & 0xffffffff | (0xffffffff >> (31 - insn->fields[1].value))
+									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
+								)
+							),
+							il.And(
+								4,
+								this->get_reg(il,insn->fields[0].value,4),
+								il.Const(
+									4,
+									//(0xffffffff >> (32 - insn->fields[2].value)) & 0xffffffff
+									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
+								)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_BGE:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_SGE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BGT:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_SGT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BLE:
+			case N850_BINS3:
 			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_SLE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
+				// 🚫0012a8b8  bins          r2, 0x0, 0x4, r1
+				// 🚫0012a8b8  bins          r2, 0x0, 0x3, r1 - RAW
+				/*
+					pos = 1
+					width = 2
+					msb = pos + width - 1
+					lsb = pos
+				*/
+				//LogInfo("BINS AT %x",addr); //  , 
+				// 00152dd2: 
+					//00152dd2  bins          r1, 0x2, 0x7, r2 - > RAW
+					//00152dd2  bins          r1, 0x2, 0x6, r2
 
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
+				// 008536ba:
+					//008536ba  bins          r23, 0x8, 0xf, r15 -> RAW
+					//008536ba  bins          r23, 0x8, 0x8, r15
+				il.AddInstruction(
+					il.SetRegister(
+						4,
+						insn->fields[3].value,
+						il.Or(
+							4,
+							il.And(
+								4,
+								this->get_reg(il,insn->fields[3].value,4),
+								il.Const(
+									4,
+									//(0xffffffff << (insn->fields[1].value + insn->fields[2].value - 1)) & 0xffffffff | (0xffffffff >> (31 - insn->fields[1].value))
+									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
+								)
+							),
+							il.And(
+								4,
+								this->get_reg(il,insn->fields[0].value,4),
+								il.Const(
+									4,
+									//(0xffffffff >> (32 - insn->fields[2].value)) & 0xffffffff
+									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
+								)
+							)
+						)
+					)
+				);
 			}
 			break;
-			case N850_BLT:
+			case N850_BSW:
 			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_SLT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
+				il.AddInstruction(
+					il.SetRegister(
+						4,
+						insn->fields[1].value,
+						il.Or(
+							4,
+							il.Or(
+								4,
+								il.ShiftLeft(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff
+										)
+									),
+									il.Const(
+										4,
+										24
+									)
+								),
+								il.ShiftLeft(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff00
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
+								)
 
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
+							),
+							il.Or(
+								4,
+								il.LogicalShiftRight(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff000000
+										)
+									),
+									il.Const(
+										4,
+										24
+									)
+								),
+								il.LogicalShiftRight(
+									4,
+									il.And(
+										4,
+										this->get_reg(il,insn->fields[0].value,4),
+										il.Const(
+											4,
+											0xff0000
+										)
+									),
+									il.Const(
+										4,
+										8
+									)
+								)
+							)
+						)
+					)
+				);
 			}
 			break;
-			case N850_BH:
+			case N850_CALLT:
 			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_UGT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BL:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_ULT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNH:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_ULE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNL:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_UGE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BE:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_E);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNE:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_NE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BC:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_ULT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BN:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_NEG);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNC:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_UGE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNV:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_NO);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BNZ:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_NE);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BP:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_POS);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BR:
-			{
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-			}
-			break;
-			case N850_BSA:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.Flag(FLAG_SAT);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-			
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BV:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_O);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BZ:
-			{
-				// True branch
-				true_label = il.GetLabelForAddress(this, insn->fields[0].value);
-				// False Branch
-				false_label = il.GetLabelForAddress(this, ((uint32_t) addr + insn->size));
-				condition = il.FlagCondition(LLFC_E);
-				if (true_label && false_label)
-					il.AddInstruction(il.If(condition,*true_label,*false_label));            
-				else if (true_label)
-					il.AddInstruction(il.If(condition,*true_label,false_tag));
-				else if (false_label)
-					il.AddInstruction(il.If(condition,true_tag,*false_label));
-				else
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-
-				if (!true_label) {
-					il.MarkLabel(true_tag);
-				}
-
-				il.AddInstruction(il.Jump(il.ConstPointer(4,(insn->fields[0].value + addr) & 0xFFFFFFFF)));
-
-				if (!false_label) {
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_BSH:
-			{
-				// TODO test
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Or(
-							4,
-							il.Or(
-								4,
-								il.ShiftLeft(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								),
-								il.LogicalShiftRight(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff00
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								)
-
-							),
-							il.Or(
-								4,
-								il.LogicalShiftRight(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff000000
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								),
-								il.ShiftLeft(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff0000
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_BINS:
-			{
-				// TODO check disassembly again
-				// 🚫001ac798  bins          r29, 0x10, 0x8, r8
-				// 🚫001ac798  bins          r29, 0x10, 0x7, r8
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[3].value,
-						il.Or(
-							4,
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[3].value,4),
-								il.Const(
-									4,
-									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
-								)
-							),
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[0].value,4),
-								il.Const(
-									4,
-									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_BINS2:
-			{
-				// 🚫0012ab84  bins          r2, 0xf, 0x3, r1
-				// 🚫0012ab84  bins          r2, 0xf, 0x1, r1 - RAW
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[3].value,
-						il.Or(
-							4,
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[3].value,4),
-								il.Const(
-									4,
-									//(0xffffffff << (insn->fields[1].value + insn->fields[2].value - 1)) & 0xffffffff | (0xffffffff >> (31 - insn->fields[1].value))
-									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
-								)
-							),
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[0].value,4),
-								il.Const(
-									4,
-									//(0xffffffff >> (32 - insn->fields[2].value)) & 0xffffffff
-									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_BINS3:
-			{
-				// 🚫0012a8b8  bins          r2, 0x0, 0x4, r1
-				// 🚫0012a8b8  bins          r2, 0x0, 0x3, r1 - RAW
-				/*
-					pos = 1
-					width = 2
-					msb = pos + width - 1
-					lsb = pos
-				*/
-				//LogInfo("BINS AT %x",addr); //  , 
-				// 00152dd2: 
-					//00152dd2  bins          r1, 0x2, 0x7, r2 - > RAW
-					//00152dd2  bins          r1, 0x2, 0x6, r2
-
-				// 008536ba:
-					//008536ba  bins          r23, 0x8, 0xf, r15 -> RAW
-					//008536ba  bins          r23, 0x8, 0x8, r15
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[3].value,
-						il.Or(
-							4,
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[3].value,4),
-								il.Const(
-									4,
-									//(0xffffffff << (insn->fields[1].value + insn->fields[2].value - 1)) & 0xffffffff | (0xffffffff >> (31 - insn->fields[1].value))
-									((0xffffffff << (insn->fields[1].value + insn->fields[2].value)) & 0xffffffff | (0xffffffff >> (32 - insn->fields[1].value))) & 0xffffffff
-								)
-							),
-							il.And(
-								4,
-								this->get_reg(il,insn->fields[0].value,4),
-								il.Const(
-									4,
-									//(0xffffffff >> (32 - insn->fields[2].value)) & 0xffffffff
-									(0xffffffff >> (32 - insn->fields[2].value) << insn->fields[1].value) & 0xffffffff
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_BSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Or(
-							4,
-							il.Or(
-								4,
-								il.ShiftLeft(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff
-										)
-									),
-									il.Const(
-										4,
-										24
-									)
-								),
-								il.ShiftLeft(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff00
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								)
-
-							),
-							il.Or(
-								4,
-								il.LogicalShiftRight(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff000000
-										)
-									),
-									il.Const(
-										4,
-										24
-									)
-								),
-								il.LogicalShiftRight(
-									4,
-									il.And(
-										4,
-										this->get_reg(il,insn->fields[0].value,4),
-										il.Const(
-											4,
-											0xff0000
-										)
-									),
-									il.Const(
-										4,
-										8
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CALLT:
-			{
-				il.AddInstruction(
-					il.Call(
-						il.Load(
-							4,
-							il.Add(
-								4,
-								il.Register(
-									4,
-									NEC_SYSREG_CTBP
-								),
-								il.ZeroExtend(
-									4,
-									il.Const(
-										1,
-										insn->fields[0].value
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CAXI:
-			{
-				// TODO not checked
-				il.AddInstruction(
-					il.If(
-						il.CompareEqual(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.Load(
-								4,
-								this->get_reg(il,insn->fields[0].value,4)
-							)
-						),
-						true_tag,
-						false_tag
-					)
-				);
-				il.MarkLabel(true_tag);
-				il.AddInstruction(
-					il.Store(
-						4,
-						this->get_reg(il,insn->fields[0].value,4),
-						this->get_reg(il,insn->fields[2].value,4)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Load(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-				il.AddInstruction(il.Goto(end_tag));
-				il.MarkLabel(false_tag);
-				il.AddInstruction(
-					il.Store(
-						4,
-						this->get_reg(il,insn->fields[0].value,4),
-						il.Load(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Load(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-				il.MarkLabel(end_tag);
-			}
-			break;
-			case N850_CEILFSL:
-			{
-				// TODO none of the CEILs are checked
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.Ceil(
-							8,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CEILFSUL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.Ceil(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CEILFSUW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Ceil(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CEILFSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Ceil(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CLL:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						CLL_INTRINSIC,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_CLR1:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									2,
-									insn->fields[1].value
-								)
-							)
-						),
-						il.And(
-							1,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[2].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[1].value
-										)
-									)
-								)
-							),
-							il.Const(
-								1,
-								~(1 << insn->fields[0].value) & 0xff
-								//((1 << (instr->fields[4].value - instr->fields[3].value + 1)) - 1) << (31 - instr->fields[4].value)
-							),
-							FLAG_WRITE_Z
-						)
-						
-					)
-				);
-			}
-			break;
-			case N850_CLR1R:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						this->get_reg(il,insn->fields[1].value,4),
-						il.And(
-							1,
-							il.Load(
-								1,
-								this->get_reg(il,insn->fields[1].value,4)
-							),
-							il.ShiftLeft(
-								1,
-								il.Const(
-									1,
-									1
-								),
-								this->get_reg(il,insn->fields[0].value,1)
-							),
-							FLAG_WRITE_Z
-						)
-					)
-				);
-			}
-			break;
-			case N850_CMOV:
-			{
-				if (insn->fields[0].value == 5) {
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							this->get_reg(il,insn->fields[1].value,4)
-						)
-					);
-				} else {
-					switch (insn->fields[0].value)
-					{
-					case 2:
-						condition = il.FlagCondition(LLFC_E);
-						break;
-					case 10:
-						condition = il.FlagCondition(LLFC_NE);
-						break;
-					case 11:
-						condition = il.FlagCondition(LLFC_UGT);
-						break;
-					case 3:
-						condition = il.FlagCondition(LLFC_ULE);
-						break;
-					case 0:
-						condition = il.FlagCondition(LLFC_O);
-						break;
-					case 8:
-						condition = il.FlagCondition(LLFC_NO);
-						break;
-					case 1:
-						condition = il.FlagCondition(LLFC_ULT);
-						break;
-					case 9:
-						condition = il.FlagCondition(LLFC_UGE);
-						break;
-					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
-						break;
-					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
-						break;
-					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
-						break;
-					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
-						break;
-					case 4:
-						condition = il.FlagCondition(LLFC_NEG);
-						break;
-					case 12:
-						condition = il.FlagCondition(LLFC_POS);
-						break;
-					case 13:
-						condition = il.CompareEqual(
-							4,
-							il.Flag(
-								FLAG_SAT
-							),
-							il.Const(
-								4,
-								1
-							)
-						);
-						break;
-					default:
-						break;
-					}
-					
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							this->get_reg(il,insn->fields[1].value,4)
-						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							this->get_reg(il,insn->fields[2].value,4)
-						)
-					);
-					il.MarkLabel(end_tag);
-				}
-				
-			}
-			break;
-			case N850_CMOVFS:
-			{
-				condition = il.CompareEqual(
-					1,
-					NEC_SYSREG_FPSR,
-					il.Const(
-						1,
-						insn->fields[0].value
-					)
-					
-				);
-				il.AddInstruction(il.If(condition,true_tag,false_tag));
-				il.MarkLabel(true_tag);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[3].value,
-						this->get_reg(il,insn->fields[1].value,4)
-					)
-				);
-				il.AddInstruction(il.Goto(end_tag));
-				il.MarkLabel(false_tag);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[3].value,
-						this->get_reg(il,insn->fields[2].value,4)
-					)
-				);
-				il.MarkLabel(end_tag);
-			}
-			break;
-			case N850_CMOVI:
-			{
-				if (insn->fields[0].value == 5) {
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							il.SignExtend(
-								4,
-								il.Const(
-									1,
-									insn->fields[1].value
-								)
-							)
-						)
-					);
-				} else {
-					switch (insn->fields[0].value)
-					{
-					case 2:
-						condition = il.FlagCondition(LLFC_E);
-						break;
-					case 10:
-						condition = il.FlagCondition(LLFC_NE);
-						break;
-					case 11:
-						condition = il.FlagCondition(LLFC_UGT);
-						break;
-					case 3:
-						condition = il.FlagCondition(LLFC_ULE);
-						break;
-					case 0:
-						condition = il.FlagCondition(LLFC_O);
-						break;
-					case 8:
-						condition = il.FlagCondition(LLFC_NO);
-						break;
-					case 1:
-						condition = il.FlagCondition(LLFC_ULT);
-						break;
-					case 9:
-						condition = il.FlagCondition(LLFC_UGE);
-						break;
-					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
-						break;
-					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
-						break;
-					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
-						break;
-					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
-						break;
-					case 4:
-						condition = il.FlagCondition(LLFC_NEG);
-						break;
-					case 12:
-						condition = il.FlagCondition(LLFC_POS);
-						break;
-					case 13:
-						condition = il.CompareEqual(
-							4,
-							il.Flag(
-								FLAG_SAT
-							),
-							il.Const(
-								4,
-								1
-							)
-						);
-						break;
-					default:
-						break;
-					}
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							il.SignExtend(
-								4,
-								il.Const(
-									1,
-									insn->fields[1].value
-								)
-							)
-						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[3].value,
-							this->get_reg(il,insn->fields[2].value,4)
-						)
-					);
-					il.MarkLabel(end_tag);
-				}
-			}
-			break;
-			case N850_CMP:
-			{
-				il.AddInstruction(
-					il.Sub(
-						4,
-						this->get_reg(il,insn->fields[1].value,4),
-						this->get_reg(il,insn->fields[0].value,4),
-						FLAG_WRITE_CYOVSZ
-
-					)
-				);
-			}
-			break;
-			case N850_CMPFS:
-			{
-				// TODO bit field specifications???
-				switch (insn->fields[0].value)
-				{
-				case 0: // F
-				case 8: // SF
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								0
-							)
-						)
-					);
-					break;
-				case 2: // EQ
-				case 3: // UQE
-				case 10: // SEQ
-				case 11: // NGL
-					condition = il.FloatCompareEqual(
-						4,
-						this->get_reg(il,insn->fields[2].value,4),
-						this->get_reg(il,insn->fields[1].value,4)
-					);
-					
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								1
-							)
-						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								0
-							)
-						)
-					);
-					il.MarkLabel(end_tag);
-					break;
-				case 4: // OLT
-				case 5: // ULT
-				case 12: // LT
-				case 13: // NGE
-					condition = il.FloatCompareLessThan(
-						4,
-						this->get_reg(il,insn->fields[2].value,4),
-						this->get_reg(il,insn->fields[1].value,4)
-					);
-					
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								1
-							)
-						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								0
-							)
-						)
-					);
-					il.MarkLabel(end_tag);
-					break;
-				case 6: // OLE
-				case 7: // ULE
-				case 14: // LE
-				case 15: // NGT
-					condition = il.FloatCompareLessEqual(
-						4,
-						this->get_reg(il,insn->fields[2].value,4),
-						this->get_reg(il,insn->fields[1].value,4)
-					);
-					
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								1
-							)
-						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							NEC_SYSREG_FPSR,
-							il.Const(
-								4,
-								0
-							)
-						)
-					);
-					il.MarkLabel(end_tag);
-					break;
-				default:
-					il.AddInstruction(il.Unimplemented());
-					break;
-				}
-			}
-			break;
-			case N850_CMPI:
-			{
-				il.AddInstruction(
-					il.Sub(
-						4,
-						this->get_reg(il,insn->fields[1].value,4),
-						il.SignExtend(
-							4,
-							il.Const(
-								1,
-								insn->fields[0].value
-							)
-						),
-						FLAG_WRITE_CYOVSZ
-
-					)
-				);
-			}
-			break;
-			case N850_CTRET:
-			{
-				il.AddInstruction(il.Return(NEC_SYSREG_CTPC));
-			}
-			break;
-			case N850_CVTFHS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFLS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFSL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.FloatConvert(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFSH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFSUL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						4,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,8)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFSUW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFULS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFUWS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_CVTFWS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatConvert(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DBRET:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						NEC_SYSREG_PSW,
-						il.Register(
-							4,
-							NEC_SYSREG_DBPSW
-						)
-					)
-				);
-				il.AddInstruction(il.Return(NEC_SYSREG_DBPC));
-			}
-			break;
-			case N850_DBTRAP:
-			{
-				il.AddInstruction(
-					il.Trap(
-						insn->fields[0].value
-					)
-				);
-			}
-			break;
-			case N850_DI:
-			{
-				// Intrinsics candidate
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_EXCEPTIONS,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_DISPOSE:
-			{
-				il.AddInstruction(il.Unimplemented());
-			}
-			break;
-			case N850_DISPOSER:
-			{
-				il.AddInstruction(il.Unimplemented());
-			}
-			break;
-			case N850_DIV:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatDiv(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
-								4,
-								this->get_reg(il,insn->fields[0].value,2)
-							),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVHR:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
-								4,
-								this->get_reg(il,insn->fields[0].value,2)
-							),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
-								4,
-								this->get_reg(il,insn->fields[0].value,2)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVHU:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								this->get_reg(il,insn->fields[0].value,2)
-							),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								this->get_reg(il,insn->fields[0].value,2)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVQ:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModSigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVQU:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_DIVU:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.DivUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ModUnsigned(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_EI:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						EI_INTRINSIC,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_EIRET:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						NEC_SYSREG_PSW,
-						il.Register(
-							4,
-							NEC_SYSREG_EIPSW
-						)
-					)
-				);
-				il.AddInstruction(il.Return(il.Register(4,NEC_SYSREG_EIPC)));
-
-			}
-			break;
-			case N850_FERET:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						NEC_SYSREG_PSW,
-						il.Register(
-							4,
-							NEC_SYSREG_FEPSW
-						)
-					)
-				);
-				il.AddInstruction(il.Return(il.Register(4,NEC_SYSREG_FEPC)));
-
-			}
-			break;
-			case N850_FETRAP:
-			{
-				il.AddInstruction(
-					il.Trap(
-						insn->fields[0].value
-					)
-				);
-			}
-			break;
-			case N850_FLOORFSL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.Floor(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FLOORFSUL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.Floor(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FLOORFSUW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Floor(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FLOORFSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Floor(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FMAFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatAdd(
-							4,
-							il.FloatMult(
-								4,
-								this->get_reg(il,insn->fields[1].value,4),
-								this->get_reg(il,insn->fields[0].value,4)
-							),
-							this->get_reg(il,insn->fields[2].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FMSFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatSub(
-							4,
-							il.FloatMult(
-								4,
-								this->get_reg(il,insn->fields[1].value,4),
-								this->get_reg(il,insn->fields[0].value,4)
-							),
-							this->get_reg(il,insn->fields[2].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FNMAFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatNeg(
-							4,
-							il.FloatAdd(
-								4,
-								il.FloatMult(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									this->get_reg(il,insn->fields[0].value,4)
-								),
-								this->get_reg(il,insn->fields[2].value,4)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_FNMSFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatNeg(
-							4,
-							il.FloatSub(
-								4,
-								il.FloatMult(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									this->get_reg(il,insn->fields[0].value,4)
-								),
-								this->get_reg(il,insn->fields[2].value,4)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_HALT:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_EXCEPTIONS,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_HSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Or(
-							4,
-							il.ShiftLeft(
-								4,
-								this->get_reg(il,insn->fields[0].value,4),
-								il.Const(
-									4,
-									16
-								)
-							),
-							il.LogicalShiftRight(
-								4,
-								this->get_reg(il,insn->fields[0].value,4),
-								il.Const(
-									4,
-									16
-								)
-							)
-						),
-						FLAG_WRITE_CYOVSZ
-					)
-				);
-			}
-			break;
-			case N850_HSH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						this->get_reg(il,insn->fields[0].value,4),
-						FLAG_WRITE_CYOVSZ
-					)
-				);
-			}
-			break;
-			case N850_JARL:
-			{
-				// TODO check
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Add(
-							4,
-							this->get_reg(il,NEC_REG_PC,4),
-							il.Const(
-								4,
-								4
-							)
-						)
-						
-					)
-				);
-				il.AddInstruction(
-					il.Call(
-						il.ConstPointer(
-							4,
-							addr + insn->fields[0].value
-						)
-					)
-				);
-			}
-			break;
-			case N850_JARL2:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Add(
-							4,
-							this->get_reg(il,NEC_REG_PC,4),
-							il.Const(
-								4,
-								6
-							)
-						)
-						
-					)
-				);
-				il.AddInstruction(
-					il.Call(
-						il.ConstPointer(
-							4,
-							addr + insn->fields[0].value
-						)
-					)
-				);
-			}
-			break;
-			case N850_JARL3:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Add(
-							4,
-							this->get_reg(il,NEC_REG_PC,4),
-							il.Const(
-								4,
-								4
-							)
-						)
-						
-					)
-				);
-				il.AddInstruction(
-					il.Call(
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_JMP:
-			{
-				if (insn->fields[0].value == NEC_REG_LP) {
-					il.AddInstruction(il.Return(il.Register(4,NEC_REG_LP)));
-				} else {
-					il.AddInstruction(il.Jump(il.Register(4, insn->fields[0].value)));
-					il.MarkLabel(false_tag);
-				}
-			}
-			break;
-			case N850_JMPI:
-			{
-				il.AddInstruction(
-					il.Jump(
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.Const(
-								4,
-								insn->fields[0].value
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_JR:
-			{
-				// TODO check
-				il.AddInstruction(
-					il.Jump(
-						il.Add(
-							4,
-							il.Const(
-								4,
-								addr
-							),
-							il.SignExtend(
-								4,
-								il.Const(
-									3,
-									insn->fields[0].value
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_JRL:
-			{
-				il.AddInstruction(
-					il.Jump(
-						il.Add(
-							4,
-							il.Const(
-								4,
-								addr
-							),
-							il.Const(
-								4,
-								insn->fields[0].value
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDBL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.SignExtend(
-							4,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDBUL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDDW:
-			{
-				// TODO check 
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value + 1,
-						il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-					)
-				);
 				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
+					il.Call(
 						il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value + 4
-										)
-									)
-								)
-							)
-					)
-				);
-			}
-			break;
-			case N850_LDB:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.SignExtend(
 							4,
-							il.Load(
-								1,
-								il.Add(
+							il.Add(
+								4,
+								il.Register(
 									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDBU:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								1,
-								il.Add(
+									NEC_SYSREG_CTBP
+								),
+								il.ZeroExtend(
 									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[0].value
-										)
+									il.Const(
+										1,
+										insn->fields[0].value
 									)
 								)
 							)
@@ -3388,1382 +1612,1347 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_LDH:
+			case N850_CAXI:
 			{
+				// TODO not checked
 				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.SignExtend(
+					il.If(
+						il.CompareEqual(
 							4,
+							this->get_reg(il,insn->fields[1].value,4),
 							il.Load(
-								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[0].value
-										)
-									)
-								)
+								4,
+								this->get_reg(il,insn->fields[0].value,4)
 							)
-						)
+						),
+						true_tag,
+						false_tag
 					)
 				);
-			}
-			break;
-			case N850_LDHU:
-			{
+				il.MarkLabel(true_tag);
 				il.AddInstruction(
-					il.SetRegister(
+					il.Store(
 						4,
-						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
+						this->get_reg(il,insn->fields[0].value,4),
+						this->get_reg(il,insn->fields[2].value,4)
 					)
 				);
-			}
-			break;
-			case N850_LDW:
-			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[2].value,
 						il.Load(
 							4,
-							il.Add(
-								4,
-								this->get_reg(il,insn->fields[1].value,4),
-								il.SignExtend(
-									4,
-									il.Const(
-										2,
-										insn->fields[0].value
-									)
-								)
-							)
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
-			}
-			break;
-			case N850_LDSR:
-			{
+				il.AddInstruction(il.Goto(end_tag));
+				il.MarkLabel(false_tag);
 				il.AddInstruction(
-					il.SetRegister(
+					il.Store(
 						4,
-						insn->fields[1].value,
-						this->get_reg(il,insn->fields[0].value,4)
+						this->get_reg(il,insn->fields[0].value,4),
+						il.Load(
+							4,
+							this->get_reg(il,insn->fields[0].value,4)
+						)
 					)
 				);
-			}
-			break;
-			case N850_MOV:
-			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						this->get_reg(il,insn->fields[0].value,4)
+						insn->fields[2].value,
+						il.Load(
+							4,
+							this->get_reg(il,insn->fields[0].value,4)
+						)
 					)
 				);
+				il.MarkLabel(end_tag);
 			}
 			break;
-			case N850_MOVI5:
+			case N850_CEILFSL:
 			{
+				// TODO none of the CEILs are checked
 				il.AddInstruction(
-					il.SetRegister(
-						4,
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
 						insn->fields[1].value,
-						il.SignExtend(
-							4,
-							il.Const(
-								1,
-								insn->fields[0].value
-							)
+						il.Ceil(
+							8,
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_MOVI:
+			case N850_CEILFSUL:
 			{
 				il.AddInstruction(
-					il.SetRegister(
-						4,
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
 						insn->fields[1].value,
-						il.Const(
-							4,
-							insn->fields[0].value
+						il.Ceil(
+							8,
+							this->get_reg(il,insn->fields[0].value,8)
 						)
 					)
 				);
 			}
 			break;
-			case N850_MOVEA:
+			case N850_CLR1:
 			{
-				// 002106a2
-				
 				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
+					il.Store(
+						1,
 						il.Add(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[2].value,4),
 							il.SignExtend(
 								4,
 								il.Const(
 									2,
-									insn->fields[0].value
+									insn->fields[1].value
 								)
 							)
+						),
+						il.And(
+							1,
+							il.Load(
+								1,
+								il.Add(
+									4,
+									this->get_reg(il,insn->fields[2].value,4),
+									il.SignExtend(
+										4,
+										il.Const(
+											2,
+											insn->fields[1].value
+										)
+									)
+								)
+							),
+							il.Const(
+								1,
+								~(1 << insn->fields[0].value) & 0xff
+								//((1 << (instr->fields[4].value - instr->fields[3].value + 1)) - 1) << (31 - instr->fields[4].value)
+							),
+							FLAG_WRITE_Z
 						)
+						
 					)
 				);
-				
 			}
 			break;
-			case N850_MOVHI:
+			case N850_CLR1R:
 			{
 				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
+					il.Store(
+						1,
+						this->get_reg(il,insn->fields[1].value,4),
+						il.And(
+							1,
+							il.Load(
+								1,
+								this->get_reg(il,insn->fields[1].value,4)
+							),
 							il.ShiftLeft(
-								4,
+								1,
 								il.Const(
-									2,
-									insn->fields[0].value
+									1,
+									1
 								),
-								il.Const(
-									4,
-									16
-								)
-							)
+								this->get_reg(il,insn->fields[0].value,1)
+							),
+							FLAG_WRITE_Z
 						)
 					)
 				);
 			}
 			break;
-			case N850_MAXFS:
+			case N850_CMOV:
 			{
-				condition = il.FloatCompareGreaterThan(
-					4,
-
-					this->get_reg(il,insn->fields[0].value,4),
-					this->get_reg(il,insn->fields[1].value,4)
-				);
-				il.AddInstruction(il.If(condition,true_tag,false_tag));
-				il.MarkLabel(true_tag);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-				il.AddInstruction(il.Goto(end_tag));
-				il.MarkLabel(false_tag);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						this->get_reg(il,insn->fields[1].value,4)
-					)
-				);
-				il.MarkLabel(end_tag);
+				if (insn->fields[0].value == 5) {
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[3].value,
+							this->get_reg(il,insn->fields[1].value,4)
+						)
+					);
+				} else {
+					switch (insn->fields[0].value)
+					{
+					case 2:
+						condition = il.FlagCondition(LLFC_E);
+						break;
+					case 10:
+						condition = il.FlagCondition(LLFC_NE);
+						break;
+					case 11:
+						condition = il.FlagCondition(LLFC_UGT);
+						break;
+					case 3:
+						condition = il.FlagCondition(LLFC_ULE);
+						break;
+					case 0:
+						condition = il.FlagCondition(LLFC_O);
+						break;
+					case 8:
+						condition = il.FlagCondition(LLFC_NO);
+						break;
+					case 1:
+						condition = il.FlagCondition(LLFC_ULT);
+						break;
+					case 9:
+						condition = il.FlagCondition(LLFC_UGE);
+						break;
+					case 6:
+						condition = il.FlagGroup(FLAG_GROUP_LT);
+						break;
+					case 14:
+						condition = il.FlagGroup(FLAG_GROUP_GE);
+						break;
+					case 7:
+						condition = il.FlagGroup(FLAG_GROUP_LE);
+						break;
+					case 15:
+						condition = il.FlagGroup(FLAG_GROUP_GT);
+						break;
+					case 4:
+						condition = il.FlagCondition(LLFC_NEG);
+						break;
+					case 12:
+						condition = il.FlagCondition(LLFC_POS);
+						break;
+					case 13:
+						condition = il.CompareEqual(
+							4,
+							il.Flag(
+								FLAG_SAT
+							),
+							il.Const(
+								4,
+								1
+							)
+						);
+						break;
+					default:
+						break;
+					}
+					
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[3].value,
+							this->get_reg(il,insn->fields[1].value,4)
+						)
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[3].value,
+							this->get_reg(il,insn->fields[2].value,4)
+						)
+					);
+					il.MarkLabel(end_tag);
+				}
+				
 			}
 			break;
-			case N850_MINFS:
+			case N850_CMOVFS:
 			{
-				condition = il.FloatCompareLessThan(
-					4,
-					this->get_reg(il,insn->fields[0].value,4),
-					this->get_reg(il,insn->fields[1].value,4)
-				);
-				il.AddInstruction(il.If(condition,true_tag,false_tag));
-				il.MarkLabel(true_tag);
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						this->get_reg(il,insn->fields[0].value,4)
+				condition = il.CompareEqual(
+					1,
+					NEC_SYSREG_FPSR,
+					il.Const(
+						1,
+						insn->fields[0].value
 					)
-				);
-				il.AddInstruction(il.Goto(end_tag));
-				il.MarkLabel(false_tag);
+					
+				);
+				il.AddInstruction(il.If(condition,true_tag,false_tag));
+				il.MarkLabel(true_tag);
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
+						insn->fields[3].value,
 						this->get_reg(il,insn->fields[1].value,4)
 					)
 				);
-				il.MarkLabel(end_tag);
-			}
-			break;
-			case N850_MULFS:
-			{
+				il.AddInstruction(il.Goto(end_tag));
+				il.MarkLabel(false_tag);
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.FloatMult(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
+						insn->fields[3].value,
+						this->get_reg(il,insn->fields[2].value,4)
 					)
 				);
+				il.MarkLabel(end_tag);
 			}
 			break;
-			case N850_NEGFS:
+			case N850_CMOVI:
 			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatNeg(
+				if (insn->fields[0].value == 5) {
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,4)
+							insn->fields[3].value,
+							il.SignExtend(
+								4,
+								il.Const(
+									1,
+									insn->fields[1].value
+								)
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_RECIPFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatDiv(
+					);
+				} else {
+					switch (insn->fields[0].value)
+					{
+					case 2:
+						condition = il.FlagCondition(LLFC_E);
+						break;
+					case 10:
+						condition = il.FlagCondition(LLFC_NE);
+						break;
+					case 11:
+						condition = il.FlagCondition(LLFC_UGT);
+						break;
+					case 3:
+						condition = il.FlagCondition(LLFC_ULE);
+						break;
+					case 0:
+						condition = il.FlagCondition(LLFC_O);
+						break;
+					case 8:
+						condition = il.FlagCondition(LLFC_NO);
+						break;
+					case 1:
+						condition = il.FlagCondition(LLFC_ULT);
+						break;
+					case 9:
+						condition = il.FlagCondition(LLFC_UGE);
+						break;
+					case 6:
+						condition = il.FlagGroup(FLAG_GROUP_LT);
+						break;
+					case 14:
+						condition = il.FlagGroup(FLAG_GROUP_GE);
+						break;
+					case 7:
+						condition = il.FlagGroup(FLAG_GROUP_LE);
+						break;
+					case 15:
+						condition = il.FlagGroup(FLAG_GROUP_GT);
+						break;
+					case 4:
+						condition = il.FlagCondition(LLFC_NEG);
+						break;
+					case 12:
+						condition = il.FlagCondition(LLFC_POS);
+						break;
+					case 13:
+						condition = il.CompareEqual(
 							4,
+							il.Flag(
+								FLAG_SAT
+							),
 							il.Const(
 								4,
 								1
-							),
-							this->get_reg(il,insn->fields[0].value,4)
+							)
+						);
+						break;
+					default:
+						break;
+					}
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[3].value,
+							il.SignExtend(
+								4,
+								il.Const(
+									1,
+									insn->fields[1].value
+								)
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_ROUNDFSL:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.RoundToInt(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[3].value,
+							this->get_reg(il,insn->fields[2].value,4)
 						)
-					)
-				);
+					);
+					il.MarkLabel(end_tag);
+				}
 			}
 			break;
-			case N850_ROUNDFSUL:
+			case N850_CMPFS:
 			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						8,
-						insn->fields[1].value + 1,
-						insn->fields[1].value,
-						il.RoundToInt(
-							8,
-							this->get_reg(il,insn->fields[0].value,8)
+				// TODO bit field specifications???
+				switch (insn->fields[0].value)
+				{
+				case 0: // F
+				case 8: // SF
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								0
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_ROUNDFSUW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
+					);
+					break;
+				case 2: // EQ
+				case 3: // UQE
+				case 10: // SEQ
+				case 11: // NGL
+					condition = il.FloatCompareEqual(
 						4,
-						insn->fields[1].value,
-						il.RoundToInt(
+						this->get_reg(il,insn->fields[2].value,4),
+						this->get_reg(il,insn->fields[1].value,4)
+					);
+					
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,4)
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								1
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_ROUNDFSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								0
+							)
+						)
+					);
+					il.MarkLabel(end_tag);
+					break;
+				case 4: // OLT
+				case 5: // ULT
+				case 12: // LT
+				case 13: // NGE
+					condition = il.FloatCompareLessThan(
 						4,
-						insn->fields[1].value,
-						il.RoundToInt(
+						this->get_reg(il,insn->fields[2].value,4),
+						this->get_reg(il,insn->fields[1].value,4)
+					);
+					
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,4)
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								1
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_RSQRTFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								0
+							)
+						)
+					);
+					il.MarkLabel(end_tag);
+					break;
+				case 6: // OLE
+				case 7: // ULE
+				case 14: // LE
+				case 15: // NGT
+					condition = il.FloatCompareLessEqual(
 						4,
-						insn->fields[1].value,
-						il.FloatDiv(
+						this->get_reg(il,insn->fields[2].value,4),
+						this->get_reg(il,insn->fields[1].value,4)
+					);
+					
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
+							NEC_SYSREG_FPSR,
 							il.Const(
 								4,
 								1
-							),
-							il.FloatSqrt(
-								4,
-								this->get_reg(il,insn->fields[0].value,4)
 							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_SQRTFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatSqrt(
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,4)
+							NEC_SYSREG_FPSR,
+							il.Const(
+								4,
+								0
+							)
 						)
-					)
-				);
+					);
+					il.MarkLabel(end_tag);
+					break;
+				default:
+					il.AddInstruction(il.Unimplemented());
+					break;
+				}
 			}
 			break;
-			case N850_MUL:
+			case N850_CTRET:
 			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						4,
-						insn->fields[2].value,
-						insn->fields[1].value,
-						il.Mult(
-							8,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
+				il.AddInstruction(il.Return(NEC_SYSREG_CTPC));
 			}
 			break;
-			case N850_MULI:
+			case N850_CVTFSL:
 			{
 				il.AddInstruction(
 					il.SetRegisterSplit(
-						4,
-						insn->fields[2].value,
+						8,
+						insn->fields[1].value + 1,
 						insn->fields[1].value,
-						il.Mult(
+						il.FloatConvert(
 							8,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									2,
-									insn->fields[0].value
-								)
-								
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_MULH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Mult(
-							4,
-							this->get_reg(il,insn->fields[1].value,2),
-							this->get_reg(il,insn->fields[0].value,2)
+							this->get_reg(il,insn->fields[0].value,8)
 						)
 					)
 				);
 			}
 			break;
-			case N850_MULHIMM:
+			case N850_CVTFSUL:
 			{
 				il.AddInstruction(
-					il.SetRegister(
+					il.SetRegisterSplit(
 						4,
+						insn->fields[1].value + 1,
 						insn->fields[1].value,
-						il.Mult(
+						il.FloatConvert(
 							4,
-							this->get_reg(il,insn->fields[1].value,2),
-							il.SignExtend(
-								2,
-								il.Const(
-									2,
-									insn->fields[0].value
-								)
-							)
+							this->get_reg(il,insn->fields[0].value,8)
 						)
 					)
 				);
 			}
 			break;
-			case N850_MULHI:
+			case N850_DBRET:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.Mult(
+						NEC_SYSREG_PSW,
+						il.Register(
 							4,
-							this->get_reg(il,insn->fields[1].value,2),
-							il.Const(
-								2,
-								insn->fields[0].value
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_MULU:
-			{
-				il.AddInstruction(
-					il.SetRegisterSplit(
-						4,
-						insn->fields[2].value,
-						insn->fields[1].value,
-						il.Mult(
-							8,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
+							NEC_SYSREG_DBPSW
 						)
 					)
 				);
+				il.AddInstruction(il.Return(NEC_SYSREG_DBPC));
 			}
 			break;
-			case N850_MULUI:
+			case N850_DBTRAP:
 			{
 				il.AddInstruction(
-					il.SetRegisterSplit(
-						4,
-						insn->fields[2].value,
-						insn->fields[1].value,
-						il.Mult(
-							8,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								il.Const(
-									2,
-									insn->fields[0].value
-								)
-								
-							)
-						)
+					il.Trap(
+						insn->fields[0].value
 					)
 				);
 			}
 			break;
-			case N850_NOP:
-			{
-				il.AddInstruction(il.Nop());
-			}
-			break;
-			case N850_NOT:
+			case N850_DISPOSE:
+				Dispose(il, insn);
+				break;
+			case N850_DISPOSER:
+				Dispose(il, insn);
+				break;
+			case N850_DIV:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.Not(
+						il.DivSigned(
 							4,
+							this->get_reg(il,insn->fields[1].value,4),
 							this->get_reg(il,insn->fields[0].value,4),
 							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-			case N850_NOT1:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						il.Add(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModSigned(
 							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									2,
-									insn->fields[1].value
-								)
-							)
-						),
-						il.Xor(
-							1,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[2].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[1].value
-										)
-									)
-								)
-							),
-							il.Const(
-								1,
-								(1 << insn->fields[0].value) & 0xff
-							),
-							FLAG_WRITE_Z
-						)
-					)
-				);
-			}
-			break;
-			case N850_NOT1R:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						this->get_reg(il,insn->fields[1].value,4),
-						il.Xor(
-							1,
-							il.Load(
-								1,
-								this->get_reg(il,insn->fields[1].value,4)
-							),
-							il.ShiftLeft(
-								1,
-								il.Const(
-									1,
-									1
-								),
-								this->get_reg(il,insn->fields[0].value,1)
-							),
-							FLAG_WRITE_Z
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_OR:
+			case N850_DIVHR:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.Or(
+						il.DivSigned(
 							4,
 							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
+							il.SignExtend(
+								4,
+								this->get_reg(il,insn->fields[0].value,2)
+							),
 							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModSigned(
 							4,
-							0
+							this->get_reg(il,insn->fields[1].value,4),
+							il.SignExtend(
+								4,
+								this->get_reg(il,insn->fields[0].value,2)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_ORI:
+			case N850_DIVHU:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.Or(
+						insn->fields[1].value,
+						il.DivUnsigned(
 							4,
 							this->get_reg(il,insn->fields[1].value,4),
 							il.ZeroExtend(
 								4,
-								il.Const(
-									2,
-									insn->fields[0].value
-								)
+								this->get_reg(il,insn->fields[0].value,2)
 							),
 							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModUnsigned(
 							4,
-							0
+							this->get_reg(il,insn->fields[1].value,4),
+							il.ZeroExtend(
+								4,
+								this->get_reg(il,insn->fields[0].value,2)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_PREPARE:
-			{
-				// TODO need some example to verify
-				il.AddInstruction(il.Unimplemented());
-			}
-			break;
-			case N850_RETI:
+			case N850_DIVQ:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						NEC_SYSREG_PSW,
-						il.Register(
+						insn->fields[1].value,
+						il.DivSigned(
 							4,
-							NEC_SYSREG_EIPSW
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4),
+							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.Return(
-						il.Register(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModSigned(
 							4,
-							NEC_SYSREG_EIPC
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SAR:
+			case N850_DIVQU:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.ArithShiftRight(
+						il.DivUnsigned(
 							4,
 							this->get_reg(il,insn->fields[1].value,4),
 							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
+							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModUnsigned(
 							4,
-							0
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SARI:
+			case N850_DIVU:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.ArithShiftRight(
+						il.DivUnsigned(
 							4,
 							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								il.Const(
-									1,
-									insn->fields[0].value
-								)
-							),
-							FLAG_WRITE_CYSZ
+							this->get_reg(il,insn->fields[0].value,4),
+							FLAG_WRITE_SZ
 						)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.ModUnsigned(
 							4,
-							0
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SARR:
+			case N850_EIRET:
 			{
-				// TODO test disassembly
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.ArithShiftRight(
+						NEC_SYSREG_PSW,
+						il.Register(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
+							NEC_SYSREG_EIPSW
 						)
 					)
 				);
+				il.AddInstruction(il.Return(il.Register(4,NEC_SYSREG_EIPC)));
+
+			}
+			break;
+			case N850_FERET:
+			{
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
+					il.SetRegister(
+						4,
+						NEC_SYSREG_PSW,
+						il.Register(
 							4,
-							0
+							NEC_SYSREG_FEPSW
 						)
 					)
 				);
+				il.AddInstruction(il.Return(il.Register(4,NEC_SYSREG_FEPC)));
+
 			}
 			break;
-			case N850_SASF:
+			case N850_FETRAP:
 			{
-				if (insn->fields[0].value == 5) {
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[1].value,
-							il.Or(
-								4,
-								il.ShiftLeft(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.Const(
-										4,
-										1
-									)
-								),
-								il.Const(
-									4,
-									1
-								)
-							)
+				il.AddInstruction(
+					il.Trap(
+						insn->fields[0].value
+					)
+				);
+			}
+			break;
+			case N850_FLOORFSL:
+			{
+				il.AddInstruction(
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
+						insn->fields[1].value,
+						il.Floor(
+							8,
+							this->get_reg(il,insn->fields[0].value,8)
 						)
-					);
-				} else {
-					switch (insn->fields[0].value)
-					{
-					case 2:
-						condition = il.FlagCondition(LLFC_E);
-						break;
-					case 10:
-						condition = il.FlagCondition(LLFC_NE);
-						break;
-					case 11:
-						condition = il.FlagCondition(LLFC_UGT);
-						break;
-					case 3:
-						condition = il.FlagCondition(LLFC_ULE);
-						break;
-					case 0:
-						condition = il.FlagCondition(LLFC_O);
-						break;
-					case 8:
-						condition = il.FlagCondition(LLFC_NO);
-						break;
-					case 1:
-						condition = il.FlagCondition(LLFC_ULT);
-						break;
-					case 9:
-						condition = il.FlagCondition(LLFC_UGE);
-						break;
-					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
-						break;
-					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
-						break;
-					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
-						break;
-					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
-						break;
-					case 4:
-						condition = il.FlagCondition(LLFC_NEG);
-						break;
-					case 12:
-						condition = il.FlagCondition(LLFC_POS);
-						break;
-					case 13:
-						condition = il.CompareEqual(
-							4,
-							il.Flag(
-								FLAG_SAT
-							),
-							il.Const(
-								4,
-								1
-							)
-						);
-						break;
-					default:
-						break;
-					}
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
-							4,
-							insn->fields[1].value,
-							il.Or(
-								4,
-								il.ShiftLeft(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.Const(
-										4,
-										1
-									)
-								),
-								il.Const(
-									4,
-									1
-								)
-							)
+					)
+				);
+			}
+			break;
+			case N850_FLOORFSUL:
+			{
+				il.AddInstruction(
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
+						insn->fields[1].value,
+						il.Floor(
+							8,
+							this->get_reg(il,insn->fields[0].value,8)
 						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
+					)
+				);
+			}
+			break;
+			case N850_FMAFS:
+			{
+				il.AddInstruction(
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.FloatAdd(
 							4,
-							insn->fields[1].value,
-							il.ShiftLeft(
+							il.FloatMult(
 								4,
 								this->get_reg(il,insn->fields[1].value,4),
-								il.Const(
-									4,
-									1
-								)
-							)
+								this->get_reg(il,insn->fields[0].value,4)
+							),
+							this->get_reg(il,insn->fields[2].value,4)
 						)
-					);
-					il.MarkLabel(end_tag);
-				}
-				
+					)
+				);
 			}
 			break;
-			case N850_SATADD:
+			case N850_FMSFS:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.Add(
+						insn->fields[2].value,
+						il.FloatSub(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_ALL
+							il.FloatMult(
+								4,
+								this->get_reg(il,insn->fields[1].value,4),
+								this->get_reg(il,insn->fields[0].value,4)
+							),
+							this->get_reg(il,insn->fields[2].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SATADDI:
+			case N850_FNMAFS:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.Add(
+						insn->fields[2].value,
+						il.FloatNeg(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
+							il.FloatAdd(
 								4,
-								il.Const(
-									1,
-									insn->fields[0].value
-								)
-							),
-							FLAG_WRITE_ALL
+								il.FloatMult(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									this->get_reg(il,insn->fields[0].value,4)
+								),
+								this->get_reg(il,insn->fields[2].value,4)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SATSUB:
-			// TODO handle the saturation?
+			case N850_FNMSFS:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.Sub(
+						insn->fields[2].value,
+						il.FloatNeg(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_ALL
+							il.FloatSub(
+								4,
+								il.FloatMult(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									this->get_reg(il,insn->fields[0].value,4)
+								),
+								this->get_reg(il,insn->fields[2].value,4)
+							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SATSUBI:
+			case N850_HSW:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.Sub(
+						insn->fields[1].value,
+						il.Or(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.SignExtend(
+							il.ShiftLeft(
 								4,
+								this->get_reg(il,insn->fields[0].value,4),
 								il.Const(
-									2,
-									insn->fields[0].value
+									4,
+									16
 								)
 							),
-							FLAG_WRITE_ALL
-						)
+							il.LogicalShiftRight(
+								4,
+								this->get_reg(il,insn->fields[0].value,4),
+								il.Const(
+									4,
+									16
+								)
+							)
+						),
+						FLAG_WRITE_CYOVSZ
 					)
 				);
 			}
 			break;
-			case N850_SATSUBR:
+			case N850_JARL:
 			{
+				// TODO check
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.Sub(
+						il.Add(
 							4,
-							this->get_reg(il,insn->fields[0].value,4),
-							this->get_reg(il,insn->fields[1].value,4),
-							FLAG_WRITE_ALL
+							this->get_reg(il,NEC_REG_PC,4),
+							il.Const(
+								4,
+								4
+							)
+						)
+						
+					)
+				);
+				il.AddInstruction(
+					il.Call(
+						il.ConstPointer(
+							4,
+							addr + insn->fields[0].value
 						)
 					)
 				);
 			}
 			break;
-			case N850_SET1:
+			case N850_JARL2:
 			{
 				il.AddInstruction(
-					il.Store(
-						1,
+					il.SetRegister(
+						4,
+						insn->fields[1].value,
 						il.Add(
 							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
+							this->get_reg(il,NEC_REG_PC,4),
+							il.Const(
 								4,
-								il.Const(
-									2,
-									insn->fields[1].value
-								)
+								6
 							)
-						),
-						il.Or(
-							1,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[2].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											2,
-											insn->fields[1].value
-										)
-									)
-								)
-							),
-							il.Const(
-								1,
-								(1 << insn->fields[0].value) & 0xff
-							),
-							FLAG_WRITE_Z
 						)
+						
 					)
 				);
-			}
-			break;
-			case N850_SET1R:
-			{
 				il.AddInstruction(
-					il.Store(
-						1,
-						this->get_reg(il,insn->fields[1].value,4),
-						il.Or(
-							1,
-							il.Load(
-								1,
-								this->get_reg(il,insn->fields[1].value,4)
-							),
-							il.ShiftLeft(
-								1,
-								il.Const(
-									1,
-									1
-								),
-								this->get_reg(il,insn->fields[0].value,4)
-							),
-							FLAG_WRITE_Z
+					il.Call(
+						il.ConstPointer(
+							4,
+							addr + insn->fields[0].value
 						)
 					)
 				);
 			}
 			break;
-			case N850_SETF:
+			case N850_JARL3:
 			{
-				if (insn->fields[0].value == 5) {
-					il.AddInstruction(
-						il.SetRegister(
+				il.AddInstruction(
+					il.SetRegister(
+						4,
+						insn->fields[1].value,
+						il.Add(
 							4,
-							insn->fields[1].value,
+							this->get_reg(il,NEC_REG_PC,4),
 							il.Const(
 								4,
-								1
+								4
 							)
 						)
-					);
+						
+					)
+				);
+				il.AddInstruction(
+					il.Call(
+						this->get_reg(il,insn->fields[0].value,4)
+					)
+				);
+			}
+			break;
+			case N850_JMP:
+			{
+				if (insn->fields[0].value == NEC_REG_LP) {
+					il.AddInstruction(il.Return(il.Register(4,NEC_REG_LP)));
 				} else {
-					switch (insn->fields[0].value)
-					{
-					case 2:
-						condition = il.FlagCondition(LLFC_E);
-						break;
-					case 10:
-						condition = il.FlagCondition(LLFC_NE);
-						break;
-					case 11:
-						condition = il.FlagCondition(LLFC_UGT);
-						break;
-					case 3:
-						condition = il.FlagCondition(LLFC_ULE);
-						break;
-					case 0:
-						condition = il.FlagCondition(LLFC_O);
-						break;
-					case 8:
-						condition = il.FlagCondition(LLFC_NO);
-						break;
-					case 1:
-						condition = il.FlagCondition(LLFC_ULT);
-						break;
-					case 9:
-						condition = il.FlagCondition(LLFC_UGE);
-						break;
-					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
-						break;
-					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
-						break;
-					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
-						break;
-					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
-						break;
-					case 4:
-						condition = il.FlagCondition(LLFC_NEG);
-						break;
-					case 12:
-						condition = il.FlagCondition(LLFC_POS);
-						break;
-					case 13:
-						condition = il.CompareEqual(
+					il.AddInstruction(il.Jump(il.Register(4, insn->fields[0].value)));
+					il.MarkLabel(false_tag);
+				}
+			}
+			break;
+			case N850_JMPI:
+			{
+				il.AddInstruction(
+					il.Jump(
+						il.Add(
 							4,
-							il.Flag(
-								FLAG_SAT
-							),
+							this->get_reg(il,insn->fields[1].value,4),
 							il.Const(
 								4,
-								1
+								insn->fields[0].value
 							)
-						);
-						break;
-					default:
-						break;
-					}
-					il.AddInstruction(il.If(condition,true_tag,false_tag));
-					il.MarkLabel(true_tag);
-					il.AddInstruction(
-						il.SetRegister(
+						)
+					)
+				);
+			}
+			break;
+			case N850_JR:
+			{
+				// TODO check
+				il.AddInstruction(
+					il.Jump(
+						il.Add(
 							4,
-							insn->fields[1].value,
 							il.Const(
 								4,
-								1
+								addr
+							),
+							il.SignExtend(
+								4,
+								il.Const(
+									3,
+									insn->fields[0].value
+								)
 							)
 						)
-					);
-					il.AddInstruction(il.Goto(end_tag));
-					il.MarkLabel(false_tag);
-					il.AddInstruction(
-						il.SetRegister(
+					)
+				);
+			}
+			break;
+			case N850_JRL:
+			{
+				il.AddInstruction(
+					il.Jump(
+						il.Add(
 							4,
-							insn->fields[1].value,
 							il.Const(
 								4,
-								0
+								addr
+							),
+							il.Const(
+								4,
+								insn->fields[0].value
 							)
 						)
-					);
-					il.MarkLabel(end_tag);
-				}
+					)
+				);
 			}
 			break;
-			case N850_SHL:
+			case N850_LDDW:
 			{
+				// TODO check 
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.ShiftLeft(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
-						)
+						insn->fields[2].value + 1,
+						il.Load(
+								1,
+								il.Add(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									il.SignExtend(
+										4,
+										il.Const(
+											3,
+											insn->fields[0].value
+										)
+									)
+								)
+							)
 					)
 				);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						il.Load(
+								1,
+								il.Add(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									il.SignExtend(
+										4,
+										il.Const(
+											3,
+											insn->fields[0].value + 4
+										)
+									)
+								)
+							)
 					)
 				);
 			}
 			break;
-			case N850_SHLI:
+			case N850_MOVHI:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.ShiftLeft(
+						insn->fields[2].value,
+						il.Add(
 							4,
 							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
+							il.ShiftLeft(
 								4,
 								il.Const(
-									1,
+									2,
 									insn->fields[0].value
+								),
+								il.Const(
+									4,
+									16
 								)
-							),
-							FLAG_WRITE_CYSZ
+							)
 						)
 					)
 				);
+			}
+			break;
+			case N850_MAXFS:
+			{
+				condition = il.FloatCompareGreaterThan(
+					4,
+
+					this->get_reg(il,insn->fields[0].value,4),
+					this->get_reg(il,insn->fields[1].value,4)
+				);
+				il.AddInstruction(il.If(condition,true_tag,false_tag));
+				il.MarkLabel(true_tag);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						this->get_reg(il,insn->fields[0].value,4)
 					)
 				);
+				il.AddInstruction(il.Goto(end_tag));
+				il.MarkLabel(false_tag);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_CY,
-						il.And(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.Const(
-								4,
-								(0x80000000 >> (insn->fields[0].value - 1))
-							)
-							
-						)
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						this->get_reg(il,insn->fields[1].value,4)
 					)
 				);
+				il.MarkLabel(end_tag);
 			}
 			break;
-			case N850_SHR:
+			case N850_MINFS:
 			{
+				condition = il.FloatCompareLessThan(
+					4,
+					this->get_reg(il,insn->fields[0].value,4),
+					this->get_reg(il,insn->fields[1].value,4)
+				);
+				il.AddInstruction(il.If(condition,true_tag,false_tag));
+				il.MarkLabel(true_tag);
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[1].value,
-						il.LogicalShiftRight(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
-						)
+						insn->fields[2].value,
+						this->get_reg(il,insn->fields[0].value,4)
 					)
 				);
+				il.AddInstruction(il.Goto(end_tag));
+				il.MarkLabel(false_tag);
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
+					il.SetRegister(
+						4,
+						insn->fields[2].value,
+						this->get_reg(il,insn->fields[1].value,4)
 					)
 				);
+				il.MarkLabel(end_tag);
 			}
 			break;
-			case N850_SHRI:
+			case N850_RECIPFS:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
 						insn->fields[1].value,
-						il.ShiftLeft(
+						il.FloatDiv(
 							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
+							il.Const(
 								4,
-								il.Const(
-									1,
-									insn->fields[0].value
-								)
+								1
 							),
-							FLAG_WRITE_CYSZ
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
+			}
+			break;
+			case N850_ROUNDFSL:
+			{
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
+						insn->fields[1].value,
+						il.RoundToInt(
+							8,
+							this->get_reg(il,insn->fields[0].value,8)
 						)
 					)
 				);
+			}
+			break;
+			case N850_ROUNDFSUL:
+			{
 				il.AddInstruction(
-					il.SetFlag(
-						FLAG_CY,
-						il.And(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.Const(
-								4,
-								(1 << (insn->fields[0].value - 1))
-							)
-							
+					il.SetRegisterSplit(
+						8,
+						insn->fields[1].value + 1,
+						insn->fields[1].value,
+						il.RoundToInt(
+							8,
+							this->get_reg(il,insn->fields[0].value,8)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SLDB:
+			case N850_RSQRTFS:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.SignExtend(
+						insn->fields[1].value,
+						il.FloatDiv(
 							4,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.ZeroExtend(
-										4,
-										il.Const(
-											1,
-											insn->fields[0].value
-										)
-									)
-								)
+							il.Const(
+								4,
+								1
+							),
+							il.FloatSqrt(
+								4,
+								this->get_reg(il,insn->fields[0].value,4)
 							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SLDBU:
+			case N850_MUL:
+			{
+				il.AddInstruction(
+					il.SetRegisterSplit(
+						4,
+						insn->fields[2].value,
+						insn->fields[1].value,
+						il.Mult(
+							8,
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
+						)
+					)
+				);
+			}
+			break;
+			case N850_MULI:
 			{
 				il.AddInstruction(
-					il.SetRegister(
+					il.SetRegisterSplit(
 						4,
 						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								1,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.ZeroExtend(
-										4,
-										il.Const(
-											1,
-											insn->fields[0].value
-										)
-									)
+						insn->fields[1].value,
+						il.Mult(
+							8,
+							this->get_reg(il,insn->fields[1].value,4),
+							il.SignExtend(
+								4,
+								il.Const(
+									2,
+									insn->fields[0].value
 								)
+								
 							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SLDH:
+			case N850_MULHIMM:
 			{
 				il.AddInstruction(
 					il.SetRegister(
 						4,
-						insn->fields[2].value,
-						il.SignExtend(
+						insn->fields[1].value,
+						il.Mult(
 							4,
-							il.Load(
+							this->get_reg(il,insn->fields[1].value,2),
+							il.SignExtend(
 								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.ZeroExtend(
-										4,
-										il.Const(
-											1,
-											insn->fields[0].value
-										)
-									)
+								il.Const(
+									2,
+									insn->fields[0].value
 								)
 							)
 						)
@@ -4771,58 +2960,51 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_SLDHU:
+			case N850_MULU:
 			{
 				il.AddInstruction(
-					il.SetRegister(
+					il.SetRegisterSplit(
 						4,
 						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.ZeroExtend(
-										4,
-										il.Const(
-											1,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
+						insn->fields[1].value,
+						il.Mult(
+							8,
+							this->get_reg(il,insn->fields[1].value,4),
+							this->get_reg(il,insn->fields[0].value,4)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SLDW:
+			case N850_MULUI:
 			{
 				il.AddInstruction(
-					il.SetRegister(
+					il.SetRegisterSplit(
 						4,
 						insn->fields[2].value,
-						il.Load(
-							4,
-							il.Add(
+						insn->fields[1].value,
+						il.Mult(
+							8,
+							this->get_reg(il,insn->fields[1].value,4),
+							il.ZeroExtend(
 								4,
-								this->get_reg(il,insn->fields[1].value,4),
-								il.ZeroExtend(
-									4,
-									il.Const(
-										1,
-										insn->fields[0].value
-									)
+								il.Const(
+									2,
+									insn->fields[0].value
 								)
+								
 							)
 						)
 					)
 				);
 			}
 			break;
-			case N850_SSTB:
+			case N850_NOP:
+			{
+				il.AddInstruction(il.Nop());
+			}
+			break;
+			case N850_NOT1:
 			{
 				il.AddInstruction(
 					il.Store(
@@ -4830,108 +3012,224 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 						il.Add(
 							4,
 							this->get_reg(il,insn->fields[2].value,4),
-							il.ZeroExtend(
+							il.SignExtend(
 								4,
 								il.Const(
-									1,
+									2,
 									insn->fields[1].value
 								)
 							)
 						),
-						this->get_reg(il,insn->fields[0].value,4)
+						il.Xor(
+							1,
+							il.Load(
+								1,
+								il.Add(
+									4,
+									this->get_reg(il,insn->fields[2].value,4),
+									il.SignExtend(
+										4,
+										il.Const(
+											2,
+											insn->fields[1].value
+										)
+									)
+								)
+							),
+							il.Const(
+								1,
+								(1 << insn->fields[0].value) & 0xff
+							),
+							FLAG_WRITE_Z
+						)
 					)
 				);
 			}
 			break;
-			case N850_SSTH:
+			case N850_NOT1R:
 			{
 				il.AddInstruction(
 					il.Store(
-						2,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.ZeroExtend(
-								4,
+						1,
+						this->get_reg(il,insn->fields[1].value,4),
+						il.Xor(
+							1,
+							il.Load(
+								1,
+								this->get_reg(il,insn->fields[1].value,4)
+							),
+							il.ShiftLeft(
+								1,
 								il.Const(
 									1,
-									insn->fields[1].value
-								)
-							)
-						),
-						this->get_reg(il,insn->fields[0].value,4)
+									1
+								),
+								this->get_reg(il,insn->fields[0].value,1)
+							),
+							FLAG_WRITE_Z
+						)
 					)
 				);
 			}
 			break;
-			case N850_SSTW:
+			case N850_PREPARE:
+				Prepare(il, insn);
+				break;
+			case N850_RETI:
 			{
 				il.AddInstruction(
-					il.Store(
+					il.SetRegister(
 						4,
-						il.Add(
+						NEC_SYSREG_PSW,
+						il.Register(
 							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.ZeroExtend(
+							NEC_SYSREG_EIPSW
+						)
+					)
+				);
+				il.AddInstruction(
+					il.Return(
+						il.Register(
+							4,
+							NEC_SYSREG_EIPC
+						)
+					)
+				);
+			}
+			break;
+			case N850_SASF:
+			{
+				if (insn->fields[0].value == 5) {
+					il.AddInstruction(
+						il.SetRegister(
+							4,
+							insn->fields[1].value,
+							il.Or(
 								4,
+								il.ShiftLeft(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									il.Const(
+										4,
+										1
+									)
+								),
 								il.Const(
-									1,
-									insn->fields[1].value
+									4,
+									1
 								)
 							)
-						),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_STB:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						il.Add(
+						)
+					);
+				} else {
+					switch (insn->fields[0].value)
+					{
+					case 2:
+						condition = il.FlagCondition(LLFC_E);
+						break;
+					case 10:
+						condition = il.FlagCondition(LLFC_NE);
+						break;
+					case 11:
+						condition = il.FlagCondition(LLFC_UGT);
+						break;
+					case 3:
+						condition = il.FlagCondition(LLFC_ULE);
+						break;
+					case 0:
+						condition = il.FlagCondition(LLFC_O);
+						break;
+					case 8:
+						condition = il.FlagCondition(LLFC_NO);
+						break;
+					case 1:
+						condition = il.FlagCondition(LLFC_ULT);
+						break;
+					case 9:
+						condition = il.FlagCondition(LLFC_UGE);
+						break;
+					case 6:
+						condition = il.FlagGroup(FLAG_GROUP_LT);
+						break;
+					case 14:
+						condition = il.FlagGroup(FLAG_GROUP_GE);
+						break;
+					case 7:
+						condition = il.FlagGroup(FLAG_GROUP_LE);
+						break;
+					case 15:
+						condition = il.FlagGroup(FLAG_GROUP_GT);
+						break;
+					case 4:
+						condition = il.FlagCondition(LLFC_NEG);
+						break;
+					case 12:
+						condition = il.FlagCondition(LLFC_POS);
+						break;
+					case 13:
+						condition = il.CompareEqual(
+							4,
+							il.Flag(
+								FLAG_SAT
+							),
+							il.Const(
+								4,
+								1
+							)
+						);
+						break;
+					default:
+						break;
+					}
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
+							insn->fields[1].value,
+							il.Or(
 								4,
+								il.ShiftLeft(
+									4,
+									this->get_reg(il,insn->fields[1].value,4),
+									il.Const(
+										4,
+										1
+									)
+								),
 								il.Const(
-									2,
-									insn->fields[1].value
+									4,
+									1
 								)
 							)
-						),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_STH:
-			{
-				il.AddInstruction(
-					il.Store(
-						2,
-						il.Add(
+						)
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
+							insn->fields[1].value,
+							il.ShiftLeft(
 								4,
+								this->get_reg(il,insn->fields[1].value,4),
 								il.Const(
-									2,
-									insn->fields[1].value
+									4,
+									1
 								)
 							)
-						),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
+						)
+					);
+					il.MarkLabel(end_tag);
+				}
+				
 			}
 			break;
-			case N850_STW:
+			case N850_SET1:
 			{
 				il.AddInstruction(
 					il.Store(
-						4,
+						1,
 						il.Add(
 							4,
 							this->get_reg(il,insn->fields[2].value,4),
@@ -4943,171 +3241,162 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 								)
 							)
 						),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_STSR:
-			{
-				// TODO test disass
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_SUB:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Sub(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYOVSZ
+						il.Or(
+							1,
+							il.Load(
+								1,
+								il.Add(
+									4,
+									this->get_reg(il,insn->fields[2].value,4),
+									il.SignExtend(
+										4,
+										il.Const(
+											2,
+											insn->fields[1].value
+										)
+									)
+								)
+							),
+							il.Const(
+								1,
+								(1 << insn->fields[0].value) & 0xff
+							),
+							FLAG_WRITE_Z
 						)
 					)
 				);
 			}
 			break;
-			case N850_SUBR:
+			case N850_SET1R:
 			{
 				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Sub(
-							4,
-							this->get_reg(il,insn->fields[0].value,4),
-							this->get_reg(il,insn->fields[1].value,4),
-							FLAG_WRITE_CYOVSZ
+					il.Store(
+						1,
+						this->get_reg(il,insn->fields[1].value,4),
+						il.Or(
+							1,
+							il.Load(
+								1,
+								this->get_reg(il,insn->fields[1].value,4)
+							),
+							il.ShiftLeft(
+								1,
+								il.Const(
+									1,
+									1
+								),
+								this->get_reg(il,insn->fields[0].value,4)
+							),
+							FLAG_WRITE_Z
 						)
 					)
 				);
 			}
 			break;
-			case N850_SWITCH:
+			case N850_SETF:
 			{
-				il.AddInstruction(
-					il.Jump(
-						il.Add(
+				if (insn->fields[0].value == 5) {
+					il.AddInstruction(
+						il.SetRegister(
 							4,
+							insn->fields[1].value,
 							il.Const(
 								4,
-								addr + 2
+								1
+							)
+						)
+					);
+				} else {
+					switch (insn->fields[0].value)
+					{
+					case 2:
+						condition = il.FlagCondition(LLFC_E);
+						break;
+					case 10:
+						condition = il.FlagCondition(LLFC_NE);
+						break;
+					case 11:
+						condition = il.FlagCondition(LLFC_UGT);
+						break;
+					case 3:
+						condition = il.FlagCondition(LLFC_ULE);
+						break;
+					case 0:
+						condition = il.FlagCondition(LLFC_O);
+						break;
+					case 8:
+						condition = il.FlagCondition(LLFC_NO);
+						break;
+					case 1:
+						condition = il.FlagCondition(LLFC_ULT);
+						break;
+					case 9:
+						condition = il.FlagCondition(LLFC_UGE);
+						break;
+					case 6:
+						condition = il.FlagGroup(FLAG_GROUP_LT);
+						break;
+					case 14:
+						condition = il.FlagGroup(FLAG_GROUP_GE);
+						break;
+					case 7:
+						condition = il.FlagGroup(FLAG_GROUP_LE);
+						break;
+					case 15:
+						condition = il.FlagGroup(FLAG_GROUP_GT);
+						break;
+					case 4:
+						condition = il.FlagCondition(LLFC_NEG);
+						break;
+					case 12:
+						condition = il.FlagCondition(LLFC_POS);
+						break;
+					case 13:
+						condition = il.CompareEqual(
+							4,
+							il.Flag(
+								FLAG_SAT
 							),
-							il.SignExtend(
+							il.Const(
 								4,
-								il.ShiftLeft(
-									2,
-									il.Load(
-										2,
-										il.Add(
-											4,
-											il.Const(
-												4,
-												addr + 2
-											),
-											il.ShiftLeft(
-												4,
-												this->get_reg(il,insn->fields[0].value,4),
-												il.Const(
-													4,
-													1
-												)
-											)
-										)
-									),
-									il.Const(
-										4,
-										1
-									)
-								)
+								1
 							)
-						)
-					)
-				);
-				il.MarkLabel(end_tag);
-			}
-			break;
-			case N850_SXB:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[0].value,
-						il.SignExtend(
+						);
+						break;
+					default:
+						break;
+					}
+					il.AddInstruction(il.If(condition,true_tag,false_tag));
+					il.MarkLabel(true_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,1)
+							insn->fields[1].value,
+							il.Const(
+								4,
+								1
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_SXH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[0].value,
-						il.SignExtend(
+					);
+					il.AddInstruction(il.Goto(end_tag));
+					il.MarkLabel(false_tag);
+					il.AddInstruction(
+						il.SetRegister(
 							4,
-							this->get_reg(il,insn->fields[0].value,2)
+							insn->fields[1].value,
+							il.Const(
+								4,
+								0
+							)
 						)
-					)
-				);
-			}
-			break;
-			case N850_SYNCE:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_EXCEPTIONS,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_SYNCI:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_INSN_FETCHER,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_SYNCM:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_MEMORY_ACCESS,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_SYNCP:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SYNC_PIPELINE,
-						{ } // Inputs
-					)
-				);
+					);
+					il.MarkLabel(end_tag);
+				}
 			}
 			break;
+			case N850_SWITCH:
+				Switch(il, insn, addr);
+				break;
 			case N850_SYSCALL:
 			{
 				il.AddInstruction(il.SystemCall());
@@ -5122,27 +3411,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_TST:
-			{
-				il.AddInstruction(
-					il.And(
-						4,
-						this->get_reg(il,insn->fields[1].value,4),
-						this->get_reg(il,insn->fields[0].value,4),
-						FLAG_WRITE_SZ
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
 			case N850_TST1:
 			{
 				il.AddInstruction(
@@ -5195,22 +3463,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_SUBFS:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.FloatSub(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4)
-
-						)
-					)
-				);
-			}
-			break;
 			case N850_TRFSR:
 			{
 				il.AddInstruction(
@@ -5254,133 +3506,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_TRNCFSUW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatTrunc(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_TRNCFSW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.FloatTrunc(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-					)
-				);
-			}
-			break;
-			case N850_XOR:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Xor(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-			case N850_XORI:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Xor(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								il.Const(
-									2,
-									insn->fields[0].value
-								)
-							),
-							FLAG_WRITE_SZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-			case N850_ZXB:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[0].value,
-						il.ZeroExtend(
-							4,
-							this->get_reg(il,insn->fields[0].value,1)
-						)
-					)
-				);
-			}
-			break;
-			case N850_ZXH:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[0].value,
-						il.ZeroExtend(
-							4,
-							this->get_reg(il,insn->fields[0].value,2)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDLW:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[1].value,
-						il.Load(
-							4,
-							this->get_reg(il,insn->fields[0].value,4)
-						)
-
-					)
-				);
-			}
-			break;
 			case N850_LOOP:
 			{
 				
@@ -5501,89 +3626,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				}
 			}
 			break;
-			case N850_RIEI:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						RIE_INTRINSIC,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_ROTL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.RotateLeft(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYOVSZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_ROTLI:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.RotateLeft(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							il.ZeroExtend(
-								4,
-								il.Const(
-									1,
-									insn->fields[0].value
-								)
-							),
-							FLAG_WRITE_CYOVSZ
-						)
-					)
-				);
-			}
-			break;
-			case N850_SATADDR:
-			{
-				// TODO saturation is not actually handled here 
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_ALL
-						)
-					)
-				);
-			}
-			break;
-			case N850_SATSUBL:
-			{
-				// TODO saturation is not actually handled here 
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Sub(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_ALL
-						)
-					)
-				);
-			}
-			break;
 			case N850_SBF:
 			{
 				if (insn->fields[0].value == 5) {
@@ -5634,16 +3676,16 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 						condition = il.FlagCondition(LLFC_UGE);
 						break;
 					case 6:
-						condition = il.FlagCondition(LLFC_SLT);
+						condition = il.FlagGroup(FLAG_GROUP_LT);
 						break;
 					case 14:
-						condition = il.FlagCondition(LLFC_SGE);
+						condition = il.FlagGroup(FLAG_GROUP_GE);
 						break;
 					case 7:
-						condition = il.FlagCondition(LLFC_SLE);
+						condition = il.FlagGroup(FLAG_GROUP_LE);
 						break;
 					case 15:
-						condition = il.FlagCondition(LLFC_SGT);
+						condition = il.FlagGroup(FLAG_GROUP_GT);
 						break;
 					case 4:
 						condition = il.FlagCondition(LLFC_NEG);
@@ -5744,178 +3786,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_SHLL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ShiftLeft(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-			case N850_SHRL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.LogicalShiftRight(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-			case N850_SNOOZE:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						SNOOZE_INTRINSIC,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_STCW:
-			{
-				// TODO atomic operation not handled
-				il.AddInstruction(
-					il.Store(
-						4,
-						this->get_reg(il,insn->fields[1].value,4),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_LDHL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.SignExtend(
-							4,
-							il.Load(
-								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDHUL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.ZeroExtend(
-							4,
-							il.Load(
-								2,
-								il.Add(
-									4,
-									this->get_reg(il,insn->fields[1].value,4),
-									il.SignExtend(
-										4,
-										il.Const(
-											3,
-											insn->fields[0].value
-										)
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_LDWL:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.Load(
-							4,
-							il.Add(
-								4,
-								this->get_reg(il,insn->fields[1].value,4),
-								il.SignExtend(
-									4,
-									il.Const(
-										3,
-										insn->fields[0].value
-									)
-								)
-							)
-						)
-					)
-				);
-			}
-			break;
-			case N850_STDL:
-			{
-				il.AddInstruction(
-					il.Store(
-						1,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									3,
-									insn->fields[1].value
-								)
-							)
-						),
-						this->get_reg(il,insn->fields[0].value,1)
-					)
-				);
-			}
-			break;
 			case N850_STDW:
 			{
 				il.AddInstruction(
@@ -5941,106 +3811,46 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				);
 			}
 			break;
-			case N850_STHL:
-			{
-				il.AddInstruction(
-					il.Store(
-						2,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									3,
-									insn->fields[1].value
-								)
-							)
-						),
-						this->get_reg(il,insn->fields[0].value,2)
-					)
-				);
-			}
-			break;
-			case N850_STWL:
-			{
-				il.AddInstruction(
-					il.Store(
-						4,
-						il.Add(
-							4,
-							this->get_reg(il,insn->fields[2].value,4),
-							il.SignExtend(
-								4,
-								il.Const(
-									3,
-									insn->fields[1].value
-								)
-							)
-						),
-						this->get_reg(il,insn->fields[0].value,4)
-					)
-				);
-			}
-			break;
-			case N850_RIE:
-			{
-				il.AddInstruction(
-					il.Intrinsic(
-						{ }, // Outputs
-						RIE_INTRINSIC,
-						{ } // Inputs
-					)
-				);
-			}
-			break;
-			case N850_SHRR:
-			{
-				il.AddInstruction(
-					il.SetRegister(
-						4,
-						insn->fields[2].value,
-						il.LogicalShiftRight(
-							4,
-							this->get_reg(il,insn->fields[1].value,4),
-							this->get_reg(il,insn->fields[0].value,4),
-							FLAG_WRITE_CYSZ
-						)
-					)
-				);
-				il.AddInstruction(
-					il.SetFlag(
-						FLAG_OV,
-						il.Const(
-							4,
-							0
-						)
-					)
-				);
-			}
-			break;
-
 			default:
 				il.AddInstruction(il.Unimplemented());
 			}
 
-			free(insn);
 			return true;
 		}
-		free(insn);
 		return false;
 		/*if (addr == 0x000d0d0c) {
-			LogInfo("%s AT 0x%x: N: %d", insn->name, (uint32_t)addr,insn->n);
-			LogInfo("%s OP[0] type: %d: value: %d", insn->name, insn->fields[0].type,insn->fields[0].value);
-			LogInfo("%s OP[1] type: %d: value: %d", insn->name, insn->fields[1].type,insn->fields[1].value);
-			LogInfo("%s OP[2] type: %d: value: %d", insn->name, insn->fields[2].type,insn->fields[2].value);
+			LogInfo("%s AT 0x%x: N: %d", insn_name(insn), (uint32_t)addr,insn->n);
+			LogInfo("%s OP[0] type: %d: value: %d", insn_name(insn), insn->fields[0].type,insn->fields[0].value);
+			LogInfo("%s OP[1] type: %d: value: %d", insn_name(insn), insn->fields[1].type,insn->fields[1].value);
+			LogInfo("%s OP[2] type: %d: value: %d", insn_name(insn), insn->fields[2].type,insn->fields[2].value);
 		}*/
 	}
 
 	virtual bool GetInstructionInfo(const uint8_t *data, uint64_t addr, size_t maxLen, InstructionInfo &result) override
 	{
-		insn_t *insn;
-		if ((insn = disassemble(data)))
+		/* only control flow needs operands, everything else just needs a length */
+		uint8_t op_type;
+		uint8_t length = disassemble_length(data, maxLen, &op_type);
+		if (!length)
+			return false;
+		switch (op_type)
+		{
+		case OP_TYPE_JMP:
+		case OP_TYPE_LOOP:
+		case OP_TYPE_CJMP:
+		case OP_TYPE_CALL:
+		case OP_TYPE_RCALL:
+		case OP_TYPE_RJMP:
+		case OP_TYPE_RET:
+		case OP_TYPE_TRAP:
+			break;
+		default:
+			result.length = length;
+			return true;
+		}
+
+		const insn_t *insn = Decode(data, addr, maxLen);
+		if (insn)
 		{
 			result.length = insn->size;
 			uint32_t target;
@@ -6064,7 +3874,6 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				else
 				{
 					// LogInfo("CJMP WENT WRONG AT 0x%x", addr);
-					free(insn);
 					return false;
 				}
 				break;
@@ -6077,7 +3886,12 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 				result.AddBranch(IndirectBranch);
 				break;
 			case OP_TYPE_RJMP:
-				result.AddBranch(IndirectBranch);
+				/* dispose ..., [lp] is the usual epilogue and lifts to a Return,
+				   switch targets come from ResolveSwitchTables */
+				if (insn->insn_id == N850_DISPOSER && insn->fields[2].value == NEC_REG_LP)
+					result.AddBranch(FunctionReturn);
+				else
+					result.AddBranch(IndirectBranch);
 				break;
 			case OP_TYPE_RET:
 				result.AddBranch(FunctionReturn);
@@ -6088,93 +3902,50 @@ virtual std::string GetIntrinsicName (uint32_t intrinsic) override {
 			default:
 				break;
 			}
-			free(insn);
 			return true;
 		}
-		free(insn);
 		return false;
 	}
 
 	virtual bool GetInstructionText(const uint8_t *data, uint64_t addr, size_t &len, std::vector<InstructionTextToken> &result) override
 	{
-		insn_t *insn;
-		char tmp[256] = {0};
-		if ((insn = disassemble(data)))
+		static const BNInstructionTextTokenType token_type[] = {
+			InstructionToken,
+			TextToken,
+			OperandSeparatorToken,
+			RegisterToken,
+			IntegerToken};
+		const insn_t *insn = Decode(data, addr, len);
+		if (insn)
 		{
-
-			int name_len = strlen(insn->name);
-			for (int i = name_len; i < 14; i++)
-			{
-				tmp[i - name_len] = ' ';
-			}
+			const std::vector<InstructionTextToken> &mnemonic = mnemonicTokens[insn->row];
+			insn_token_t tokens[INSN_MAX_OPERAND_TOKENS];
+			size_t count = insn_operand_tokens(insn, addr, tokens);
 			len = insn->size;
-			tmp[14 - name_len] = 0;
-			result.emplace_back(InstructionToken, insn->name);
-			result.emplace_back(TextToken, tmp);
-			char hex_val[20] = {0};
-			char reg_str[10] = {0};
-			for (int op_index = 0; op_index < insn->n; op_index++)
+			result.reserve(result.size() + mnemonic.size() + count);
+			result.insert(result.end(), mnemonic.begin(), mnemonic.end());
+			for (size_t i = 0; i < count; i++)
 			{
-				switch (insn->fields[op_index].type)
-				{
-				case TYPE_REG:
-					result.emplace_back(RegisterToken, reg_name[insn->fields[op_index].value]);
-					break;
-				case TYPE_REG_MEM:
-					if (op_index > 0)
-						result.pop_back();
-					snprintf(reg_str, 10, "[%s]", reg_name[insn->fields[op_index].value]);
-					result.emplace_back(RegisterToken, reg_str);
-					break;
-				case TYPE_MEM:
-					if (insn->fields[op_index].value == 0)
-						break;
-					if (insn->fields[op_index].sign)
-						snprintf(hex_val, 20, "%s0x%x", ((int32_t)insn->fields[op_index].value < 0) ? "-" : "", ((int32_t)insn->fields[op_index].value < 0) ? -(int32_t)insn->fields[op_index].value : (int32_t)insn->fields[op_index].value);
-					else
-						snprintf(hex_val, 20, "0x%x", (uint32_t)insn->fields[op_index].value);
-					result.emplace_back(IntegerToken, hex_val, insn->fields[op_index].value);
-					break;
-				case TYPE_IMM:
-					if (insn->fields[op_index].sign)
-						snprintf(hex_val, 20, "%s0x%x", ((int32_t)insn->fields[op_index].value < 0) ? "-" : "", ((int32_t)insn->fields[op_index].value < 0) ? -(int32_t)insn->fields[op_index].value : (int32_t)insn->fields[op_index].value);
-					else
-						snprintf(hex_val, 20, "0x%x", (uint32_t)insn->fields[op_index].value);
-					result.emplace_back(IntegerToken, hex_val, insn->fields[op_index].value);
-					break;
-				case TYPE_JMP:
-					snprintf(hex_val, 20, "0x%x", (uint32_t)(insn->fields[op_index].value) + (uint32_t)addr); // + (uint32_t) addr));
-					result.emplace_back(IntegerToken, hex_val, insn->fields[op_index].value + addr);
-					break;
-				case TYPE_LOOP:
-					snprintf(hex_val, 20, "0x%x", (uint32_t)addr - (uint32_t)(insn->fields[op_index].value)); // + (uint32_t) addr));
-					result.emplace_back(IntegerToken, hex_val, addr - insn->fields[op_index].value);
-					break;
-				case TYPE_CCCC:
-					result.emplace_back(RegisterToken, cccc_name[insn->fields[op_index].value]);
-					break;
-				case TYPE_COND:
-					result.emplace_back(RegisterToken, cond_name[insn->fields[op_index].value]);
-					break;
-				case TYPE_SYSREG:
-					result.emplace_back(RegisterToken, this->GetSysregName(insn->fields[op_index].value));
-					break;
-				default:
-					break;
-				}
-				result.emplace_back(OperandSeparatorToken, ", ");
+				if (tokens[i].kind == INSN_TOKEN_INTEGER)
+					result.emplace_back(IntegerToken, tokens[i].text, tokens[i].value);
+				else
+					result.emplace_back(token_type[tokens[i].kind], tokens[i].text);
 			}
-			result.pop_back();
-			free(insn);
 			return true;
 		}
-		free(insn);
 		return false;
 	}
 };
 
 class Nec850CallingConvention : public CallingConvention
 {
+	const vector<uint32_t> argumentRegisters{
+		NEC_REG_R6, NEC_REG_R7, NEC_REG_R8, NEC_REG_R9};
+	const vector<uint32_t> callerSavedRegisters{
+		NEC_REG_R10, NEC_REG_R11, NEC_REG_R12, NEC_REG_R13, NEC_REG_R14, NEC_REG_R15, NEC_REG_R16, NEC_REG_R17, NEC_REG_R18, NEC_REG_R19};
+	const vector<uint32_t> calleeSavedRegisters{
+		NEC_REG_R25, NEC_REG_R25, NEC_REG_R27, NEC_REG_R28, NEC_REG_EP, NEC_REG_LP};
+
 public:
 	Nec850CallingConvention(Architecture *arch) : CallingConvention(arch, "default")
 	{
@@ -6182,8 +3953,7 @@ public:
 
 	virtual vector<uint32_t> GetIntegerArgumentRegisters() override
 	{
-		return vector<uint32_t>{
-			NEC_REG_R6, NEC_REG_R7, NEC_REG_R8, NEC_REG_R9};
+		return argumentRegisters;
 	}
 
 	virtual uint32_t GetIntegerReturnValueRegister() override
@@ -6193,14 +3963,12 @@ public:
 
 	virtual vector<uint32_t> GetCallerSavedRegisters() override
 	{
-		return vector<uint32_t>{
-			NEC_REG_R10, NEC_REG_R11, NEC_REG_R12, NEC_REG_R13, NEC_REG_R14, NEC_REG_R15, NEC_REG_R16, NEC_REG_R17, NEC_REG_R18, NEC_REG_R19};
+		return callerSavedRegisters;
 	}
 
 	virtual vector<uint32_t> GetCalleeSavedRegisters() override
 	{
-		return vector<uint32_t>{
-			NEC_REG_R25, NEC_REG_R25, NEC_REG_R27, NEC_REG_R28, NEC_REG_EP, NEC_REG_LP};
+		return calleeSavedRegisters;
 	}
 };
 extern "C"
@@ -6217,8 +3985,11 @@ extern "C"
 	BINARYNINJAPLUGIN bool CorePluginInit()
 	{
 
+		/* prepare the decoder before analysis threads start using it */
+		disassemble_init();
+
 		/* create, register arch in global list of available architectures */
-		Architecture *nec850 = new NEC850("nec850");
+		NEC850 *nec850 = new NEC850("nec850");
 		Architecture::Register(nec850);
 		Ref<CallingConvention> conv;
 		conv = new Nec850CallingConvention(nec850);
@@ -6238,6 +4009,102 @@ extern "C"
 			LittleEndian,
 			nec850);
 
+		PluginCommand::Register("NEC850\\Decode cache statistics", "Log hit/miss counts of the per-thread decode cache", [nec850](BinaryView *) {
+			uint64_t hits, misses;
+			nec850->GetDecodeCacheStats(hits, misses);
+			LogInfo("nec850 decode cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate)",
+				hits, misses, hits + misses ? 100.0 * hits / (hits + misses) : 0.0);
+		});
+
+		PluginCommand::Register("NEC850\\Seed functions from call targets", "Scan executable segments for jarl instructions and add their targets as functions", [nec850](BinaryView *view) {
+			struct SeedContext {
+				BinaryView *view;
+				vector<uint64_t> targets;
+			} ctx = {view, {}};
+			size_t sites = 0;
+			for (auto& segment: view->GetSegments())
+			{
+				if (!(segment->GetFlags() & SegmentExecutable))
+					continue;
+				vector<uint8_t> buffer(segment->GetLength());
+				buffer.resize(view->Read(buffer.data(), segment->GetStart(), buffer.size()));
+				sites += scan_branches(buffer.data(), buffer.size(), (uint32_t)segment->GetStart(), [](void *arg, const branch_site_t *site) {
+					SeedContext *ctx = (SeedContext *)arg;
+					if (site->op_type == OP_TYPE_CALL && site->target && ctx->view->IsOffsetExecutable(site->target))
+						ctx->targets.push_back(site->target);
+				}, &ctx);
+			}
+			sort(ctx.targets.begin(), ctx.targets.end());
+			ctx.targets.erase(unique(ctx.targets.begin(), ctx.targets.end()), ctx.targets.end());
+			Ref<Platform> platform = view->GetDefaultPlatform();
+			for (uint64_t target: ctx.targets)
+				view->AddFunctionForAnalysis(platform, target);
+			LogInfo("nec850: %zu branch sites, %zu call targets queued for analysis", sites, ctx.targets.size());
+		}, [nec850](BinaryView *view) {
+			return view->GetDefaultArchitecture() == nec850;
+		});
+
+		PluginCommand::Register("NEC850\\Resolve switch tables", "Set the guarded table targets of unresolved switch instructions as indirect branches", [nec850](BinaryView *view) {
+			size_t resolved = nec850->ResolveSwitchTables(view);
+			if (resolved)
+				view->UpdateAnalysis();
+			LogInfo("nec850: %zu switch tables resolved", resolved);
+		}, [nec850](BinaryView *view) {
+			return view->GetDefaultArchitecture() == nec850;
+		});
+
+		PluginCommand::Register("NEC850\\LLIL size statistics", "Log the lifted instruction, basic block and constant jump counts of all functions", [nec850](BinaryView *view) {
+			size_t functions = 0, instructions = 0, blocks = 0, constantJumps = 0;
+			for (auto &function : view->GetAnalysisFunctionList())
+			{
+				Ref<LowLevelILFunction> llil = function->GetLowLevelIL();
+				if (!llil)
+					continue;
+				functions++;
+				instructions += llil->GetInstructionCount();
+				blocks += llil->GetBasicBlocks().size();
+				/* a branch whose target had no label is lifted as a Jump to a constant */
+				for (size_t i = 0; i < llil->GetInstructionCount(); i++)
+				{
+					LowLevelILInstruction instr = llil->GetInstruction(i);
+					if (instr.operation == LLIL_JUMP && instr.GetDestExpr<LLIL_JUMP>().operation == LLIL_CONST_PTR)
+						constantJumps++;
+				}
+			}
+			LogInfo("nec850: %zu functions, %zu LLIL instructions, %zu LLIL basic blocks, %zu jumps to constant addresses",
+				functions, instructions, blocks, constantJumps);
+		}, [nec850](BinaryView *view) {
+			return view->GetDefaultArchitecture() == nec850;
+		});
+
+		PluginCommand::RegisterForAddress("NEC850\\Export segment listing", "Write an objdump-style listing of the segment at this address to a file", [](BinaryView *view, uint64_t addr) {
+			Ref<Segment> segment = view->GetSegmentAt(addr);
+			string path;
+			if (!segment || !GetSaveFileNameInput(path, "Listing file", "*.txt", "listing.txt"))
+				return;
+			FILE *out = fopen(path.c_str(), "w");
+			if (!out)
+			{
+				LogError("nec850: cannot write %s", path.c_str());
+				return;
+			}
+			vector<uint8_t> buffer(segment->GetLength());
+			buffer.resize(view->Read(buffer.data(), segment->GetStart(), buffer.size()));
+			/* one text buffer for the whole segment, drained to the file whenever it fills */
+			InsnListing listing;
+			size_t lines = 0;
+			for (size_t offset = 0; offset < buffer.size();)
+			{
+				offset += listing.Render(buffer.data() + offset, buffer.size() - offset, (uint32_t)(segment->GetStart() + offset));
+				fwrite(listing.text, 1, listing.len, out);
+				lines += listing.lines;
+			}
+			fclose(out);
+			LogInfo("nec850: wrote %zu lines for 0x%" PRIx64 "-0x%" PRIx64 " to %s", lines, segment->GetStart(), segment->GetEnd(), path.c_str());
+		}, [nec850](BinaryView *view, uint64_t addr) {
+			return view->GetDefaultArchitecture() == nec850 && view->GetSegmentAt(addr);
+		});
+
 		return true;
 	}
 }
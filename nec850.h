@@ -23,7 +23,9 @@
 #ifndef TESTPLUGIN_LIBRARY_H
 #define TESTPLUGIN_LIBRARY_H
 
+#ifdef __cplusplus
 #include "binaryninjaapi.h"
+#endif
 
 #endif //TESTPLUGIN_LIBRARY_H
 #define NEC_REG_R0  0
@@ -110,6 +112,18 @@
 #define FLAG_WRITE_Z 9
 #define FLAG_WRITE_SZ 10
 #define FLAG_WRITE_CYSZ 11
+// logic and shift results clear OV
+#define FLAG_WRITE_SZ_OV0 12
+#define FLAG_WRITE_CYSZ_OV0 13
+
+// semantic class of the OV clearing writes, the others use the default class 0
+#define FLAG_CLASS_LOGIC 1
+
+// signed conditions, they need OV only after arithmetic
+#define FLAG_GROUP_LT 0
+#define FLAG_GROUP_GE 1
+#define FLAG_GROUP_LE 2
+#define FLAG_GROUP_GT 3
 
 enum cond {
     NEC850_CCCC_V = 0,
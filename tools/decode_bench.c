@@ -0,0 +1,312 @@
+// Decoder throughput benchmark, builds without Binary Ninja.
+//
+//   nec850_decode_bench [-t seconds] [raw_image]
+//
+// Each workload is swept linearly (invalid halfwords are skipped two bytes at
+// a time) with every decoder entry point, repeating until the time budget is
+// spent, and reported as ns/instruction and million instructions per second.
+// The integer operands of each workload are then formatted with snprintf and
+// with insn_format_hex, the formatter behind the operand tokens, and reported
+// as ns/operand after checking that both produce the same text.
+#include "disass.h"
+#include "insn_text.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VARIANTS_PER_ROW 64
+#define RANDOM_BYTES (4 << 20)
+
+typedef struct {
+    const char *name;
+    uint8_t *data;
+    size_t len;
+} workload_t;
+
+typedef size_t (*sweep_fn)(const uint8_t *data, size_t len);
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    // xorshift64*, fixed seed so runs are comparable
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dull;
+}
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static size_t sweep_disassemble(const uint8_t *data, size_t len) {
+    size_t count = 0;
+    uint8_t window[INSN_MAX_SIZE] = {0};
+    for (size_t offset = 0; offset + 2 <= len;) {
+        // disassemble() may read INSN_MAX_SIZE bytes, so copy the tail
+        const uint8_t *in = data + offset;
+        if (len - offset < INSN_MAX_SIZE) {
+            memcpy(window, in, len - offset);
+            in = window;
+        }
+        insn_t *insn = disassemble(in);
+        if (insn) {
+            offset += insn->size;
+            count++;
+            free(insn);
+        } else {
+            offset += 2;
+        }
+    }
+    return count;
+}
+
+static size_t sweep_into(const uint8_t *data, size_t len) {
+    size_t count = 0;
+    insn_t insn;
+    for (size_t offset = 0; offset + 2 <= len;) {
+        if (disassemble_into(data + offset, len - offset, &insn) == DISASS_OK) {
+            offset += insn.size;
+            count++;
+        } else {
+            offset += 2;
+        }
+    }
+    return count;
+}
+
+static size_t sweep_length(const uint8_t *data, size_t len) {
+    size_t count = 0;
+    uint8_t op_type;
+    for (size_t offset = 0; offset + 2 <= len;) {
+        uint8_t size = disassemble_length(data + offset, len - offset, &op_type);
+        if (size) {
+            offset += size;
+            count++;
+        } else {
+            offset += 2;
+        }
+    }
+    return count;
+}
+
+static size_t sweep_batch(const uint8_t *data, size_t len) {
+    static uint32_t address[1024];
+    static uint8_t size[1024];
+    static uint16_t insn_id[1024];
+    static uint8_t op_type[1024];
+    static int32_t values[1024 * INSN_MAX_OPERANDS];
+    insn_batch_t batch = {1024, 0, address, size, insn_id, op_type, values};
+    size_t count = 0;
+    for (size_t offset = 0; offset + 2 <= len;) {
+        size_t consumed = disassemble_batch(data + offset, len - offset, (uint32_t)offset, &batch);
+        for (size_t i = 0; i < batch.count; i++)
+            count += batch.insn_id[i] != DISASS_BATCH_INVALID;
+        offset += consumed;
+    }
+    return count;
+}
+
+typedef struct {
+    uint32_t value;
+    int is_signed;
+} hex_operand_t;
+
+typedef size_t (*hex_fn)(char *out, uint32_t value, int is_signed);
+
+static size_t hex_snprintf(char *out, uint32_t value, int is_signed) {
+    if (is_signed && (int32_t)value < 0)
+        return (size_t)snprintf(out, INSN_HEX_SIZE, "-0x%x", 0u - value);
+    return (size_t)snprintf(out, INSN_HEX_SIZE, "0x%x", value);
+}
+
+// The integer operands of a linear sweep, as insn_tokens prints them at address 0.
+static size_t collect_hex(const uint8_t *data, size_t len, hex_operand_t **out) {
+    size_t count = 0, capacity = 1024;
+    hex_operand_t *ops = malloc(capacity * sizeof(hex_operand_t));
+    insn_t insn;
+    for (size_t offset = 0; offset + 2 <= len;) {
+        if (disassemble_into(data + offset, len - offset, &insn) != DISASS_OK) {
+            offset += 2;
+            continue;
+        }
+        for (int i = 0; i < insn.n; i++) {
+            const insn_op_t *op = &insn.fields[i];
+            hex_operand_t hex = {(uint32_t)op->value, op->sign};
+            if (op->type == TYPE_JMP)
+                hex.value = (uint32_t)op->value + (uint32_t)offset, hex.is_signed = 0;
+            else if (op->type == TYPE_LOOP)
+                hex.value = (uint32_t)offset - (uint32_t)op->value, hex.is_signed = 0;
+            else if (op->type != TYPE_IMM && !(op->type == TYPE_MEM && op->value != 0))
+                continue;
+            if (count == capacity)
+                ops = realloc(ops, (capacity *= 2) * sizeof(hex_operand_t));
+            ops[count++] = hex;
+        }
+        offset += insn.size;
+    }
+    *out = ops;
+    return count;
+}
+
+static void run_hex(const workload_t *w, const char *formatter, hex_fn format, const hex_operand_t *ops, size_t count, double budget) {
+    char text[INSN_HEX_SIZE];
+    size_t total = 0, sink = 0;
+    int passes = 0;
+    double elapsed;
+    double start = now();
+    do {
+        for (size_t i = 0; i < count; i++)
+            sink += format(text, ops[i].value, ops[i].is_signed) + (uint8_t)text[2];
+        total += count;
+        passes++;
+        elapsed = now() - start;
+    } while (elapsed < budget);
+    printf("%-16.16s %-18s %10zu %9d %10.2f %10zu\n", w->name, formatter, count, passes,
+        total ? elapsed * 1e9 / total : 0.0, sink / passes);
+}
+
+static void bench_hex(const workload_t *w, double budget) {
+    hex_operand_t *ops;
+    size_t count = collect_hex(w->data, w->len, &ops);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        char expected[INSN_HEX_SIZE], actual[INSN_HEX_SIZE];
+        hex_snprintf(expected, ops[i].value, ops[i].is_signed);
+        insn_format_hex(actual, ops[i].value, ops[i].is_signed);
+        mismatches += strcmp(expected, actual) != 0;
+    }
+    if (mismatches)
+        printf("%s: insn_format_hex differs from snprintf on %zu of %zu operands\n", w->name, mismatches, count);
+    run_hex(w, "snprintf", hex_snprintf, ops, count, budget);
+    run_hex(w, "insn_format_hex", insn_format_hex, ops, count, budget);
+    free(ops);
+}
+
+static void encode(uint64_t word, uint16_t size, uint8_t *out) {
+    // halfwords are stored little-endian, most significant halfword first
+    for (int i = 0; i < size / 2; i++) {
+        uint16_t half = (uint16_t)(word >> (size * 8 - 16 * (i + 1)));
+        out[2 * i] = (uint8_t)half;
+        out[2 * i + 1] = (uint8_t)(half >> 8);
+    }
+}
+
+static void build_rows(workload_t *w) {
+    size_t len = 0;
+    uint32_t reached = 0;
+    for (uint32_t i = 0; i < instruction_count; i++)
+        len += (size_t)instruction_list[i].size * VARIANTS_PER_ROW;
+    w->name = "rows";
+    w->data = malloc(len);
+    w->len = len;
+    len = 0;
+    for (uint32_t i = 0; i < instruction_count; i++) {
+        const disass_insn_t *row = &instruction_list[i];
+        uint64_t width = row->size == 8 ? ~0ull : (1ull << (row->size * 8)) - 1;
+        int hit = 0;
+        for (int v = 0; v < VARIANTS_PER_ROW; v++) {
+            // the fixed bits plus random operand bits, the first variant has no operand bits
+            uint64_t word = row->static_mask | (v ? next_random() & row->mask & width : 0);
+            insn_t insn;
+            encode(word, row->size, w->data + len);
+            if (!hit && disassemble_into(w->data + len, row->size, &insn) == DISASS_OK && insn.row == i)
+                hit = 1;
+            len += row->size;
+        }
+        reached += hit;
+    }
+    printf("rows: %u of %u table rows decode to themselves\n", reached, instruction_count);
+}
+
+static void build_random(workload_t *w) {
+    w->name = "random";
+    w->data = malloc(RANDOM_BYTES);
+    w->len = RANDOM_BYTES;
+    for (size_t i = 0; i < RANDOM_BYTES; i += 8) {
+        uint64_t r = next_random();
+        memcpy(w->data + i, &r, 8);
+    }
+}
+
+static int load_file(workload_t *w, const char *path) {
+    FILE *f = fopen(path, "rb");
+    long size;
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    w->name = path;
+    w->data = malloc(size > 0 ? (size_t)size : 1);
+    w->len = fread(w->data, 1, size > 0 ? (size_t)size : 0, f);
+    fclose(f);
+    return 1;
+}
+
+static void run(const workload_t *w, const char *decoder, sweep_fn sweep, double budget) {
+    size_t insns = 0;
+    int passes = 0;
+    double elapsed;
+    double start = now();
+    do {
+        insns += sweep(w->data, w->len);
+        passes++;
+        elapsed = now() - start;
+    } while (elapsed < budget);
+    printf("%-16.16s %-18s %10zu %9d %10.2f %10.2f\n", w->name, decoder, insns / passes, passes,
+        insns ? elapsed * 1e9 / insns : 0.0, insns / elapsed / 1e6);
+}
+
+int main(int argc, char **argv) {
+    static const struct {
+        const char *name;
+        sweep_fn sweep;
+    } decoders[] = {
+        {"disassemble", sweep_disassemble},
+        {"disassemble_into", sweep_into},
+        {"disassemble_length", sweep_length},
+        {"disassemble_batch", sweep_batch},
+    };
+    workload_t workloads[3];
+    int n = 0;
+    double budget = 0.5;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            budget = atof(argv[++i]);
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: %s [-t seconds] [raw_image]\n", argv[0]);
+            return 1;
+        } else
+            path = argv[i];
+    }
+
+    disassemble_init();
+    build_rows(&workloads[n++]);
+    build_random(&workloads[n++]);
+    if (path) {
+        if (!load_file(&workloads[n], path))
+            return 1;
+        n++;
+    }
+
+    printf("%-16s %-18s %10s %9s %10s %10s\n", "workload", "decoder", "insns", "passes", "ns/insn", "Minsn/s");
+    for (int i = 0; i < n; i++) {
+        for (size_t d = 0; d < sizeof(decoders) / sizeof(decoders[0]); d++)
+            run(&workloads[i], decoders[d].name, decoders[d].sweep, budget);
+    }
+
+    printf("\n%-16s %-18s %10s %9s %10s %10s\n", "workload", "formatter", "operands", "passes", "ns/op", "checksum");
+    for (int i = 0; i < n; i++) {
+        bench_hex(&workloads[i], budget);
+        free(workloads[i].data);
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+// Decoder conformance check, builds without Binary Ninja and runs under CTest.
+//
+//   nec850_decode_check
+//
+// Every first halfword, followed by a fixed set of tails (all zeros, all ones
+// and random bits), is decoded with disassemble_into() for 2, 4 and 6 available
+// bytes and compared with a reference first-match walk over instruction_list.
+// The reference is the original table decoder: the first row whose size fits
+// and whose mask/static_mask accept the bytes wins, and its operands are built
+// by the generic field loop. disassemble_length() must agree with
+// disassemble_into() on the size and op_type, and fail when it fails, and the
+// first entry of disassemble_batch() must carry the same size, ids and operand
+// values. Any difference is printed and fails the check.
+#include "disass.h"
+#include <stdio.h>
+#include <string.h>
+
+#define RANDOM_TAILS 14
+#define MAX_REPORTS 20
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    // xorshift64*, fixed seed so failures reproduce
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dull;
+}
+
+// Reference decode of in_buffer, row < 0 when no row matches.
+static int reference_decode(const uint8_t *in_buffer, size_t avail, insn_t *out) {
+    for (uint32_t i = 0; i < instruction_count; i++) {
+        const disass_insn_t *row = &instruction_list[i];
+        uint64_t data = 0;
+        int64_t value[INSN_MAX_OPERANDS] = {0};
+        if (row->size > avail)
+            continue;
+        for (int b = 0; b < row->size; b += 2) {
+            data |= (uint64_t)in_buffer[b + 1] << ((row->size - (b + 1)) * 8);
+            data |= (uint64_t)in_buffer[b] << ((row->size - (b + 2)) * 8);
+        }
+        if ((row->mask & data) != data || (row->static_mask & data) != row->static_mask)
+            continue;
+
+        memset(out, 0, sizeof(*out));
+        out->row = (uint16_t)i;
+        out->size = (uint8_t)row->size;
+        out->op_type = (uint8_t)row->op_type;
+        out->cond = (uint8_t)row->cond;
+        out->insn_id = (uint8_t)row->insn_id;
+        out->n = (uint8_t)row->n;
+        for (int f = 0; f < 5; f++) {
+            const disass_op_t *field = &row->fields[f];
+            insn_op_t *op = &out->fields[field->index];
+            if (field->mask == 0)
+                continue;
+            op->size += (uint8_t)field->size;
+            op->sign = (uint8_t)field->sign;
+            if (field->type == TYPE_EP) {
+                value[field->index] = 30;
+                op->type = TYPE_REG_MEM;
+                continue;
+            }
+            value[field->index] |= ((int64_t)(data & field->mask) >> field->shr << field->shl) + field->add;
+            op->type = (uint8_t)field->type;
+        }
+        for (int o = 0; o < INSN_MAX_OPERANDS; o++) {
+            insn_op_t *op = &out->fields[o];
+            if ((op->type == TYPE_IMM || op->type == TYPE_JMP || op->type == TYPE_MEM) && op->sign == SIGNED) {
+                int64_t m = (int64_t)1 << (op->size - 1);
+                value[o] = (value[o] ^ m) - m;
+            }
+            if (op->type == TYPE_BINS2 || op->type == TYPE_BINS3) {
+                value[o] = value[o] - (value[1] - 1);
+                op->type = TYPE_IMM;
+            } else if (op->type == TYPE_BINS) {
+                value[o] = value[o] - (value[1] - 0x10) + 1;
+                op->type = TYPE_IMM;
+            } else if (op->type == TYPE_SYSREG) {
+                value[o] += (value[2] * 40) + 100;
+            }
+            op->value = (int32_t)value[o];
+        }
+        return (int)i;
+    }
+    return -1;
+}
+
+static int same_insn(const insn_t *a, const insn_t *b) {
+    if (a->row != b->row || a->size != b->size || a->op_type != b->op_type || a->cond != b->cond
+        || a->insn_id != b->insn_id || a->n != b->n)
+        return 0;
+    for (int o = 0; o < INSN_MAX_OPERANDS; o++) {
+        const insn_op_t *x = &a->fields[o], *y = &b->fields[o];
+        if (x->value != y->value || x->size != y->size || x->sign != y->sign || x->type != y->type)
+            return 0;
+    }
+    return 1;
+}
+
+static void report(const char *what, const uint8_t *bytes, size_t avail, const char *detail, int verbose) {
+    if (!verbose)
+        return;
+    printf("%s:", what);
+    for (size_t i = 0; i < INSN_MAX_SIZE; i++)
+        printf(" %02x", bytes[i]);
+    printf(" (avail %zu) %s\n", avail, detail);
+}
+
+// disassemble_into() against the reference walk, 1 on a mismatch, which is
+// printed when verbose.
+static size_t check_decode(const uint8_t *bytes, size_t avail, int verbose) {
+    insn_t got, want;
+    int want_row = reference_decode(bytes, avail, &want);
+    enum disass_status status = disassemble_into(bytes, avail, &got);
+    char detail[96];
+
+    if (want_row < 0 && status == DISASS_INVALID)
+        return 0;
+    if (want_row < 0 || status != DISASS_OK) {
+        snprintf(detail, sizeof(detail), "reference %s, disassemble_into %s",
+            want_row < 0 ? "invalid" : instruction_list[want_row].name,
+            status == DISASS_OK ? instruction_list[got.row].name : "invalid");
+        report("decode", bytes, avail, detail, verbose);
+        return 1;
+    }
+    if (!same_insn(&got, &want)) {
+        snprintf(detail, sizeof(detail), "reference row %u (%s), disassemble_into row %u (%s)",
+            want.row, instruction_list[want.row].name, got.row, instruction_list[got.row].name);
+        report("decode", bytes, avail, detail, verbose);
+        return 1;
+    }
+    return 0;
+}
+
+// disassemble_length() against disassemble_into(), 1 on a mismatch.
+static size_t check_length(const uint8_t *bytes, size_t avail, int verbose) {
+    insn_t insn;
+    uint8_t op_type = OP_TYPE_ILL;
+    uint8_t length = disassemble_length(bytes, avail, &op_type);
+    char detail[96];
+
+    if (disassemble_into(bytes, avail, &insn) != DISASS_OK) {
+        if (length == 0)
+            return 0;
+        snprintf(detail, sizeof(detail), "disassemble_into invalid, disassemble_length %u", length);
+        report("length", bytes, avail, detail, verbose);
+        return 1;
+    }
+    if (length != insn.size || op_type != insn.op_type) {
+        snprintf(detail, sizeof(detail), "%s is %u bytes op_type %u, disassemble_length %u bytes op_type %u",
+            instruction_list[insn.row].name, insn.size, insn.op_type, length, op_type);
+        report("length", bytes, avail, detail, verbose);
+        return 1;
+    }
+    return 0;
+}
+
+// The first disassemble_batch() entry against disassemble_into(), 1 on a mismatch.
+static size_t check_batch(const uint8_t *bytes, size_t avail, int verbose) {
+    uint32_t address;
+    uint8_t size, op_type;
+    uint16_t insn_id;
+    int32_t values[INSN_MAX_OPERANDS];
+    insn_batch_t batch = {1, 0, &address, &size, &insn_id, &op_type, values};
+    insn_t insn;
+    size_t consumed = disassemble_batch(bytes, avail, 0, &batch);
+    char detail[96];
+    int same;
+
+    if (disassemble_into(bytes, avail, &insn) != DISASS_OK) {
+        if (consumed == 2 && batch.count == 1 && insn_id == DISASS_BATCH_INVALID && size == 2)
+            return 0;
+        snprintf(detail, sizeof(detail), "disassemble_into invalid, disassemble_batch insn_id %u", insn_id);
+        report("batch", bytes, avail, detail, verbose);
+        return 1;
+    }
+    same = consumed == insn.size && batch.count == 1 && size == insn.size && insn_id == insn.insn_id
+        && op_type == insn.op_type;
+    for (int o = 0; o < INSN_MAX_OPERANDS; o++)
+        same = same && values[o] == insn.fields[o].value;
+    if (!same) {
+        snprintf(detail, sizeof(detail), "%s differs in disassemble_batch", instruction_list[insn.row].name);
+        report("batch", bytes, avail, detail, verbose);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    static const size_t avails[] = {2, 4, 6};
+    uint8_t tails[RANDOM_TAILS + 2][INSN_MAX_SIZE - 2];
+    size_t checked = 0, failures = 0;
+
+    disassemble_init();
+    memset(tails[0], 0x00, sizeof(tails[0]));
+    memset(tails[1], 0xff, sizeof(tails[1]));
+    for (int t = 2; t < RANDOM_TAILS + 2; t++) {
+        uint64_t r = next_random();
+        memcpy(tails[t], &r, sizeof(tails[t]));
+    }
+
+    for (uint32_t first = 0; first < 0x10000; first++) {
+        for (int t = 0; t < RANDOM_TAILS + 2; t++) {
+            uint8_t bytes[INSN_MAX_SIZE];
+            bytes[0] = (uint8_t)first;
+            bytes[1] = (uint8_t)(first >> 8);
+            memcpy(bytes + 2, tails[t], sizeof(tails[t]));
+            for (size_t a = 0; a < sizeof(avails) / sizeof(avails[0]); a++) {
+                failures += check_decode(bytes, avails[a], failures < MAX_REPORTS);
+                failures += check_length(bytes, avails[a], failures < MAX_REPORTS);
+                failures += check_batch(bytes, avails[a], failures < MAX_REPORTS);
+                checked++;
+            }
+        }
+    }
+
+    printf("nec850_decode_check: %zu decodes checked, %zu mismatches\n", checked, failures);
+    return failures != 0;
+}
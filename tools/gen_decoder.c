@@ -0,0 +1,219 @@
+// Build-time generator: compiles instruction_list into a decision tree.
+//
+//   nec850_gen_decoder decode_tree.c report.txt
+//
+// Every row is a ternary pattern over the 48-bit word of decode_tree.h (bits
+// that must be 0, must be 1, or are free). A node switches on the contiguous
+// field of up to MAX_FIELD_BITS bits that best splits its rows. Each case
+// keeps, in table order, the rows that can still match, so the first-match
+// semantics of the table walk are preserved. Nodes with the same rows are
+// emitted once and shared. A leaf tests its remaining rows with one
+// and/compare each.
+//
+// The generator also reports rows that can never be returned: rows shadowed
+// by an earlier row of the same or smaller size, and rows whose fixed bits
+// contradict their mask (those are left out of the tree). Pairs of rows that
+// share some encodings go to the report file.
+#include "disass.h"
+#include "decode_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_FIELD_BITS 6
+#define MAX_NODES 4096
+
+typedef struct {
+    uint64_t care;  // bits the row tests
+    uint64_t ones;  // bits that must be set, the other care bits must be clear
+    uint8_t size;
+} pattern_t;
+
+typedef struct {
+    uint16_t *rows;
+    uint32_t count;
+    // split field, bits == 0 for a leaf
+    uint8_t lo;
+    uint8_t bits;
+    uint32_t children[1 << MAX_FIELD_BITS];
+} node_t;
+
+static pattern_t patterns[1024];
+static node_t nodes[MAX_NODES];
+static uint32_t node_count = 0;
+
+static void make_pattern(const disass_insn_t *row, pattern_t *out) {
+    uint16_t shift = DECODE_WORD_BITS - row->size * 8;
+    uint64_t window = ((uint64_t)1 << (row->size * 8)) - 1;
+    out->care = ((~row->mask & window) | row->static_mask) << shift;
+    out->ones = row->static_mask << shift;
+    out->size = row->size;
+}
+
+// Can the row match a word whose bits in the field hold value?
+static int fits(const pattern_t *p, uint8_t lo, uint8_t bits, uint64_t value) {
+    uint64_t field = (((uint64_t)1 << bits) - 1) << lo;
+    return ((value << lo) & p->care & field) == (p->ones & field);
+}
+
+static uint32_t find_node(const uint16_t *rows, uint32_t count) {
+    for (uint32_t i = 0; i < node_count; i++)
+        if (nodes[i].count == count && memcmp(nodes[i].rows, rows, count * sizeof(uint16_t)) == 0)
+            return i;
+    return UINT32_MAX;
+}
+
+static uint32_t build(const uint16_t *rows, uint32_t count) {
+    uint32_t found = find_node(rows, count);
+    uint32_t self;
+    double best_cost = 0;
+    uint8_t best_lo = 0, best_bits = 0;
+    uint16_t *child = malloc((count ? count : 1) * sizeof(uint16_t));
+
+    if (found != UINT32_MAX) {
+        free(child);
+        return found;
+    }
+    if (node_count == MAX_NODES) {
+        fprintf(stderr, "nec850_gen_decoder: more than %d nodes\n", MAX_NODES);
+        exit(1);
+    }
+    self = node_count++;
+    nodes[self].rows = malloc((count ? count : 1) * sizeof(uint16_t));
+    memcpy(nodes[self].rows, rows, count * sizeof(uint16_t));
+    nodes[self].count = count;
+    nodes[self].bits = 0;
+
+    // a split must shrink every case, otherwise the node stays a leaf
+    for (uint8_t bits = 1; count > 1 && bits <= MAX_FIELD_BITS; bits++) {
+        for (uint8_t lo = 0; lo + bits <= DECODE_WORD_BITS; lo++) {
+            uint32_t total = 0, largest = 0;
+            for (uint64_t value = 0; value < ((uint64_t)1 << bits); value++) {
+                uint32_t n = 0;
+                for (uint32_t i = 0; i < count; i++)
+                    n += fits(&patterns[rows[i]], lo, bits, value);
+                total += n;
+                largest = n > largest ? n : largest;
+            }
+            double cost = (double)total / ((uint64_t)1 << bits);
+            if (largest < count && (best_bits == 0 || cost < best_cost)) {
+                best_cost = cost;
+                best_lo = lo;
+                best_bits = bits;
+            }
+        }
+    }
+
+    if (best_bits) {
+        nodes[self].lo = best_lo;
+        nodes[self].bits = best_bits;
+        for (uint64_t value = 0; value < ((uint64_t)1 << best_bits); value++) {
+            uint32_t n = 0;
+            for (uint32_t i = 0; i < count; i++)
+                if (fits(&patterns[rows[i]], best_lo, best_bits, value))
+                    child[n++] = rows[i];
+            nodes[self].children[value] = build(child, n);
+        }
+    }
+    free(child);
+    return self;
+}
+
+static void emit(FILE *out) {
+    fprintf(out, "// Generated by nec850_gen_decoder from instruction_list, do not edit.\n");
+    fprintf(out, "#include \"decode_tree.h\"\n\n");
+    fprintf(out, "int decode_tree(uint64_t word, size_t avail) {\n");
+    fprintf(out, "    goto node_0;\n");
+    for (uint32_t i = 0; i < node_count; i++) {
+        node_t *node = &nodes[i];
+        fprintf(out, "node_%u:\n", i);
+        if (node->bits) {
+            fprintf(out, "    switch ((word >> %u) & 0x%x) {\n", node->lo, (1u << node->bits) - 1);
+            // the cases cover every field value, the last one is the default
+            // so the compiler sees that the switch never falls through
+            for (uint32_t value = 0; value + 1 < (1u << node->bits); value++)
+                fprintf(out, "    case %u: goto node_%u;\n", value, node->children[value]);
+            fprintf(out, "    default: goto node_%u;\n", node->children[(1u << node->bits) - 1]);
+            fprintf(out, "    }\n");
+            continue;
+        }
+        for (uint32_t r = 0; r < node->count; r++) {
+            const pattern_t *p = &patterns[node->rows[r]];
+            const char *name = instruction_list[node->rows[r]].name;
+            if (p->size > 2)
+                fprintf(out, "    if ((word & 0x%012llxull) == 0x%012llxull && avail >= %u) return %u; // %s\n",
+                    (unsigned long long)p->care, (unsigned long long)p->ones, p->size, node->rows[r], name);
+            else
+                fprintf(out, "    if ((word & 0x%012llxull) == 0x%012llxull) return %u; // %s\n",
+                    (unsigned long long)p->care, (unsigned long long)p->ones, node->rows[r], name);
+        }
+        fprintf(out, "    return -1;\n");
+    }
+    fprintf(out, "}\n");
+}
+
+static int unmatchable(uint32_t row) {
+    return (instruction_list[row].static_mask & ~instruction_list[row].mask) != 0;
+}
+
+static int report(FILE *out) {
+    int dead = 0;
+    uint32_t overlaps = 0;
+    for (uint32_t j = 0; j < instruction_count; j++) {
+        const pattern_t *pj = &patterns[j];
+        if (unmatchable(j)) {
+            printf("nec850_gen_decoder: row %u (%s) can never match, its fixed bits are outside its mask\n", j, instruction_list[j].name);
+            fprintf(out, "row %u (%s): unmatchable\n", j, instruction_list[j].name);
+            dead++;
+            continue;
+        }
+        for (uint32_t i = 0; i < j; i++) {
+            const pattern_t *pi = &patterns[i];
+            if (unmatchable(i) || ((pi->ones ^ pj->ones) & pi->care & pj->care) != 0)
+                continue;
+            // every encoding of j also matches the earlier row i
+            if (pi->size <= pj->size && (pi->care & ~pj->care) == 0) {
+                printf("nec850_gen_decoder: row %u (%s) is shadowed by row %u (%s)\n", j, instruction_list[j].name, i, instruction_list[i].name);
+                fprintf(out, "row %u (%s): shadowed by row %u (%s)\n", j, instruction_list[j].name, i, instruction_list[i].name);
+                dead++;
+                break;
+            }
+            fprintf(out, "row %u (%s): overlaps row %u (%s), which wins\n", j, instruction_list[j].name, i, instruction_list[i].name);
+            overlaps++;
+        }
+    }
+    printf("nec850_gen_decoder: %u rows, %u tree nodes, %d unreachable rows, %u overlapping pairs\n",
+        instruction_count, node_count, dead, overlaps);
+    return dead;
+}
+
+int main(int argc, char **argv) {
+    uint16_t *rows = malloc(instruction_count * sizeof(uint16_t));
+    uint32_t count = 0;
+    FILE *source, *report_file;
+
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s decode_tree.c report.txt\n", argv[0]);
+        return 1;
+    }
+    for (uint32_t i = 0; i < instruction_count; i++) {
+        make_pattern(&instruction_list[i], &patterns[i]);
+        // the table walk never matches a row with fixed bits outside its mask
+        if (!unmatchable(i))
+            rows[count++] = (uint16_t)i;
+    }
+    build(rows, count);
+
+    source = fopen(argv[1], "w");
+    report_file = fopen(argv[2], "w");
+    if (!source || !report_file) {
+        perror("nec850_gen_decoder");
+        return 1;
+    }
+    emit(source);
+    report(report_file);
+    fclose(source);
+    fclose(report_file);
+    free(rows);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+int map_file(const char *path, mapped_file_t *file) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return 0;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        CloseHandle(handle);
+        return 0;
+    }
+    file->file = handle;
+    file->mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    file->data = file->mapping ? MapViewOfFile((HANDLE)file->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!file->data) {
+        if (file->mapping)
+            CloseHandle((HANDLE)file->mapping);
+        CloseHandle(handle);
+        return 0;
+    }
+    file->len = (size_t)size.QuadPart;
+    return 1;
+#else
+    struct stat st;
+    void *data;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return 0;
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+    file->data = data;
+    file->len = (size_t)st.st_size;
+    file->file = file->mapping = NULL;
+    return 1;
+#endif
+}
+
+void unmap_file(mapped_file_t *file) {
+#ifdef _WIN32
+    UnmapViewOfFile(file->data);
+    CloseHandle((HANDLE)file->mapping);
+    CloseHandle((HANDLE)file->file);
+#else
+    munmap((void *)file->data, file->len);
+#endif
+}
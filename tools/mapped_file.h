@@ -0,0 +1,27 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+// Read-only memory mapping of a whole file, shared by the command line tools.
+typedef struct {
+  const uint8_t *data;
+  size_t len;
+  void *file;     // Windows file and mapping handles
+  void *mapping;
+} mapped_file_t;
+
+// Returns 0 if the file cannot be opened, is empty or cannot be mapped.
+int map_file(const char *path, mapped_file_t *file);
+void unmap_file(mapped_file_t *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAPPED_FILE_H
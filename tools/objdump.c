@@ -0,0 +1,130 @@
+// Streaming disassembler for raw images and ELF files, builds without Binary
+// Ninja and prints operands the way the plugin does.
+//
+//   nec850-objdump [-b base] file
+//
+// ELF files are disassembled section by section (every SHF_EXECINSTR section),
+// anything else is treated as a raw image loaded at base (default 0).
+#include "disass.h"
+#include "insn_text.h"
+#include "mapped_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OUT_BUFFER_SIZE (256 * 1024)
+
+#define ELF_SHT_NOBITS 8
+#define ELF_SHF_EXECINSTR 0x4
+
+static char out_buffer[OUT_BUFFER_SIZE];
+static size_t out_len = 0;
+
+static void out_flush(void) {
+    fwrite(out_buffer, 1, out_len, stdout);
+    out_len = 0;
+}
+
+static void out_write(const char *text, size_t len) {
+    if (out_len + len > OUT_BUFFER_SIZE)
+        out_flush();
+    memcpy(out_buffer + out_len, text, len);
+    out_len += len;
+}
+
+// Renders straight into the output buffer, flushing whenever it fills up.
+static void disassemble_range(const uint8_t *data, size_t len, uint32_t address) {
+    for (size_t offset = 0; offset < len;) {
+        insn_listing_t listing = {out_buffer + out_len, OUT_BUFFER_SIZE - out_len, 0, 0};
+        offset += insn_render(data + offset, len - offset, address + (uint32_t)offset, &listing);
+        out_len += listing.len;
+        if (offset < len)
+            out_flush();
+    }
+}
+
+static uint32_t read16(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8;
+}
+
+static uint32_t read32(const uint8_t *p) {
+    return read16(p) | read16(p + 2) << 16;
+}
+
+// Little-endian ELF32 only, which is all the V850 toolchains produce. Returns 0
+// if the file is not such an ELF.
+static int disassemble_elf(const uint8_t *data, size_t len) {
+    char header[128];
+    uint32_t shoff, shentsize, shnum, shstrndx;
+    const uint8_t *strtab;
+    size_t strtab_len;
+
+    if (len < 52 || memcmp(data, "\x7f" "ELF", 4) != 0 || data[4] != 1 || data[5] != 1)
+        return 0;
+    shoff = read32(data + 32);
+    shentsize = read16(data + 46);
+    shnum = read16(data + 48);
+    shstrndx = read16(data + 50);
+    if (shentsize < 40 || shstrndx >= shnum || shoff > len || (size_t)shnum * shentsize > len - shoff)
+        return 0;
+    strtab = data + shoff + shstrndx * shentsize;
+    if (read32(strtab + 16) <= len && read32(strtab + 20) <= len - read32(strtab + 16)) {
+        strtab_len = read32(strtab + 20);
+        strtab = data + read32(strtab + 16);
+    } else {
+        strtab_len = 0;
+    }
+
+    for (uint32_t i = 0; i < shnum; i++) {
+        const uint8_t *section = data + shoff + i * shentsize;
+        uint32_t name = read32(section);
+        uint32_t type = read32(section + 4);
+        uint32_t flags = read32(section + 8);
+        uint32_t addr = read32(section + 12);
+        uint32_t offset = read32(section + 16);
+        uint32_t size = read32(section + 20);
+        if (!(flags & ELF_SHF_EXECINSTR) || type == ELF_SHT_NOBITS)
+            continue;
+        if (offset > len || size > len - offset)
+            size = offset > len ? 0 : (uint32_t)(len - offset);
+        if (name < strtab_len)
+            snprintf(header, sizeof(header), "\nDisassembly of section %.*s:\n\n",
+                (int)(strtab_len - name < 64 ? strtab_len - name : 64), (const char *)strtab + name);
+        else
+            snprintf(header, sizeof(header), "\nDisassembly of section %u:\n\n", i);
+        out_write(header, strlen(header));
+        disassemble_range(data + offset, size, addr);
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    mapped_file_t file;
+    uint32_t base = 0;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            base = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (argv[i][0] == '-' || path) {
+            fprintf(stderr, "usage: %s [-b base] file\n", argv[0]);
+            return 1;
+        } else
+            path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [-b base] file\n", argv[0]);
+        return 1;
+    }
+    if (!map_file(path, &file)) {
+        fprintf(stderr, "%s: cannot map %s\n", argv[0], path);
+        return 1;
+    }
+
+    disassemble_init();
+    if (!disassemble_elf(file.data, file.len))
+        disassemble_range(file.data, file.len, base);
+    out_flush();
+    unmap_file(&file);
+    return 0;
+}
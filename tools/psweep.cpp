@@ -0,0 +1,326 @@
+// Parallel linear-sweep disassembler for large raw images, builds without
+// Binary Ninja. The output is byte-identical to nec850-objdump on the same
+// image.
+//
+//   nec850-psweep [-j threads] [-c chunk_kib] [-b base] file
+//   nec850-psweep -B [-j max_threads] [-c chunk_kib] file
+//
+// The image is cut into fixed-size chunks. Every chunk after the first starts
+// its sweep at the first halfword that decodes and renders its lines into a
+// private buffer. The writer joins the chunks in address order: it follows the
+// sweep of the previous chunk into the next one and steps through the chunk's
+// own instruction starts with disassemble_length until both sweeps meet,
+// usually within a few instructions, re-decoding serially in the rare case
+// that they never do.
+// -B runs the sweep with 1, 2, 4 ... threads instead and reports the scaling.
+#include "disass.h"
+#include "insn_text.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct Chunk
+{
+	size_t begin;                // nominal byte range [begin, end)
+	size_t end;
+	size_t first;                // where the chunk's sweep starts
+	size_t stop;                 // first offset past the sweep, >= end unless the image ends
+	unique_ptr<char[]> text;     // the rendered lines, not initialised past length
+	size_t capacity;
+	size_t length;
+};
+
+/* Each worker owns a deque of chunk indices. A worker that runs dry steals the
+   oldest task of another worker. Workers never take a chunk more than window
+   chunks ahead of the writer, which bounds the rendered text held in memory. */
+class WorkStealingPool
+{
+	struct Queue
+	{
+		mutex lock;
+		deque<size_t> tasks;
+	};
+
+	vector<unique_ptr<Queue>> queues;
+	vector<thread> workers;
+	size_t window;
+
+	mutex progressLock;
+	condition_variable progress;
+	size_t written = 0;
+	vector<bool> finished;
+
+	bool TryTake(Queue &queue, size_t limit, size_t &task)
+	{
+		lock_guard<mutex> guard(queue.lock);
+		if (queue.tasks.empty() || queue.tasks.front() >= limit)
+			return false;
+		task = queue.tasks.front();
+		queue.tasks.pop_front();
+		return true;
+	}
+
+	bool Take(size_t self, size_t &task)
+	{
+		for (;;)
+		{
+			size_t limit;
+			{
+				lock_guard<mutex> guard(progressLock);
+				limit = written + window;
+			}
+			for (size_t i = 0; i < queues.size(); i++)
+				if (TryTake(*queues[(self + i) % queues.size()], limit, task))
+					return true;
+
+			unique_lock<mutex> guard(progressLock);
+			bool empty = true;
+			for (auto &queue : queues)
+			{
+				lock_guard<mutex> queueGuard(queue->lock);
+				empty = empty && queue->tasks.empty();
+			}
+			if (empty)
+				return false;
+			// everything left is too far ahead of the writer
+			progress.wait(guard, [&] { return written + window != limit; });
+		}
+	}
+
+public:
+	WorkStealingPool(size_t threads, size_t tasks, size_t window, function<void(size_t)> run) : window(window), finished(tasks)
+	{
+		for (size_t i = 0; i < threads; i++)
+			queues.emplace_back(new Queue);
+		for (size_t task = 0; task < tasks; task++)
+			queues[task % threads]->tasks.push_back(task);
+		for (size_t i = 0; i < threads; i++)
+		{
+			workers.emplace_back([this, i, run] {
+				size_t task;
+				while (Take(i, task))
+				{
+					run(task);
+					lock_guard<mutex> guard(progressLock);
+					finished[task] = true;
+					progress.notify_all();
+				}
+			});
+		}
+	}
+
+	~WorkStealingPool()
+	{
+		for (auto &worker : workers)
+			worker.join();
+	}
+
+	void WaitFor(size_t task)
+	{
+		unique_lock<mutex> guard(progressLock);
+		progress.wait(guard, [&] { return finished[task]; });
+	}
+
+	void Written(size_t task)
+	{
+		lock_guard<mutex> guard(progressLock);
+		written = task + 1;
+		progress.notify_all();
+	}
+};
+
+// Bytes that insn_line consumes at offset.
+static size_t LineSize(const uint8_t *data, size_t len, size_t offset)
+{
+	uint8_t op_type;
+	uint8_t size = disassemble_length(data + offset, len - offset, &op_type);
+	return size ? size : min<size_t>(2, len - offset);
+}
+
+static void SweepChunk(const uint8_t *data, size_t len, uint32_t base, Chunk &chunk)
+{
+	uint8_t size, op_type;
+	size_t offset = chunk.begin;
+
+	// resynchronise on the first halfword that is a valid instruction start
+	if (offset != 0)
+		while (offset < chunk.end && offset + 2 <= len && !disassemble_length(data + offset, len - offset, &op_type))
+			offset += 2;
+	chunk.first = offset;
+
+	// random code renders to about 20 bytes of text per byte, grown if not enough
+	chunk.capacity = 24 * (chunk.end - chunk.begin) + INSN_LINE_SIZE;
+	chunk.text.reset(new char[chunk.capacity]);
+	chunk.length = 0;
+	for (; offset < chunk.end; offset += size)
+	{
+		if (chunk.capacity - chunk.length < INSN_LINE_SIZE)
+		{
+			unique_ptr<char[]> text(new char[2 * chunk.capacity]);
+			memcpy(text.get(), chunk.text.get(), chunk.length);
+			chunk.text = move(text);
+			chunk.capacity *= 2;
+		}
+		chunk.length += insn_line(data + offset, len - offset, base + (uint32_t)offset, chunk.text.get() + chunk.length, &size);
+	}
+	chunk.stop = offset;
+}
+
+/* Emits the lines of chunk that the serial sweep would produce when it enters
+   the chunk at offset entry, returns where the serial sweep leaves it. */
+template <typename Emit>
+static size_t JoinChunk(const uint8_t *data, size_t len, uint32_t base, const Chunk &chunk, size_t entry, Emit &emit)
+{
+	char line[INSN_LINE_SIZE];
+	uint8_t size;
+	size_t offset = entry;
+	// the chunk's sweep, one line of text per instruction start
+	size_t start = chunk.first;
+	const char *text = chunk.text.get();
+	const char *textEnd = text + chunk.length;
+
+	while (offset < chunk.end)
+	{
+		while (start < offset && start < chunk.stop)
+		{
+			start += LineSize(data, len, start);
+			text = (const char *)memchr(text, '\n', textEnd - text) + 1;
+		}
+		if (start == offset)
+		{
+			// both sweeps agree from here on
+			emit(text, textEnd - text);
+			return chunk.stop;
+		}
+		emit(line, insn_line(data + offset, len - offset, base + (uint32_t)offset, line, &size));
+		offset += size;
+	}
+	return offset;
+}
+
+template <typename Emit>
+static void Sweep(const uint8_t *data, size_t len, uint32_t base, size_t threads, size_t chunkSize, Emit &&emit)
+{
+	size_t count = (len + chunkSize - 1) / chunkSize;
+	vector<Chunk> chunks(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		chunks[i].begin = i * chunkSize;
+		chunks[i].end = min(len, (i + 1) * chunkSize);
+	}
+
+	WorkStealingPool pool(threads, count, 4 * threads, [&](size_t i) { SweepChunk(data, len, base, chunks[i]); });
+	size_t entry = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		pool.WaitFor(i);
+		entry = JoinChunk(data, len, base, chunks[i], entry, emit);
+		// release the rendered text as soon as it is out
+		chunks[i].text.reset();
+		pool.Written(i);
+	}
+}
+
+static void Usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-j threads] [-c chunk_kib] [-b base] file\n"
+		"       %s -B [-j max_threads] [-c chunk_kib] file\n", name, name);
+}
+
+int main(int argc, char **argv)
+{
+	size_t threads = max(1u, thread::hardware_concurrency());
+	size_t chunkSize = 256 * 1024;
+	uint32_t base = 0;
+	bool bench = false;
+	const char *path = NULL;
+	mapped_file_t file;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-j") && i + 1 < argc)
+			threads = max(1ul, strtoul(argv[++i], NULL, 0));
+		else if (!strcmp(argv[i], "-c") && i + 1 < argc)
+			chunkSize = max(1ul, strtoul(argv[++i], NULL, 0)) * 1024;
+		else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+			base = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (!strcmp(argv[i], "-B"))
+			bench = true;
+		else if (argv[i][0] == '-' || path)
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+		else
+			path = argv[i];
+	}
+	if (!path)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+	if (!map_file(path, &file))
+	{
+		fprintf(stderr, "%s: cannot map %s\n", argv[0], path);
+		return 1;
+	}
+
+	disassemble_init();
+	if (!bench)
+	{
+		static char buffer[1 << 20];
+		setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+		Sweep(file.data, file.len, base, threads, chunkSize, [](const char *text, size_t n) { fwrite(text, 1, n, stdout); });
+		fflush(stdout);
+		unmap_file(&file);
+		return 0;
+	}
+
+	// every run hashes its output to check that it does not depend on the thread count
+	uint64_t reference = 0;
+	double serial = 0;
+	printf("%8s %10s %10s %8s  %s\n", "threads", "seconds", "MB/s", "speedup", "output");
+	for (size_t n = 1;; n = min(n * 2, threads))
+	{
+		uint64_t hash = 0xcbf29ce484222325ull;
+		auto start = chrono::steady_clock::now();
+		Sweep(file.data, file.len, base, n, chunkSize, [&](const char *text, size_t len) {
+			// FNV-1a over 8-byte words, so that hashing does not become the serial bottleneck
+			uint64_t word;
+			size_t i = 0;
+			for (; i + 8 <= len; i += 8)
+			{
+				memcpy(&word, text + i, 8);
+				hash = (hash ^ word) * 0x100000001b3ull;
+			}
+			word = 0;
+			memcpy(&word, text + i, len - i);
+			hash = (hash ^ word ^ len) * 0x100000001b3ull;
+		});
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (n == 1)
+		{
+			reference = hash;
+			serial = seconds;
+		}
+		printf("%8zu %10.3f %10.1f %8.2f  %s\n", n, seconds, file.len / seconds / 1e6, serial / seconds,
+			hash == reference ? "identical" : "DIFFERS");
+		if (n == threads)
+			break;
+	}
+	unmap_file(&file);
+	return 0;
+}